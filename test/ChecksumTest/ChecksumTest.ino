@@ -17,6 +17,22 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added checksum() zero length and long block tests, and fletcher16,
+ * fletcher32 and adler32 tests.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added ipv4_sum_copy and ipv4_sum_combine tests.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added l4_checksum_v4/v6 tests.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added ipv4_checksum_update tests.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added ipv4_checksum() odd length, zero length, unaligned and long block tests.
+ *
  * 10/07/2015 - Tom Kerr
  * Added support for automated unit testing over a serial port.
  *
@@ -35,8 +51,8 @@
  * Contains the setup() and loop() functions for the program.  Also uses the
  * aunit pseudo test framework to execute the tests.
  *
- * Copy aunit.cpp, aunit.h, UnionTypeDefs.h, Checksum.c and Checksum.h into your 
- * sketch folder.  This sketch tests all functions in the Checksum.c module.
+ * Copy aunit.cpp, aunit.h, UnionTypeDefs.h, Iovec.h, Checksum.c and Checksum.h
+ * into your sketch folder.  This sketch tests all functions in the Checksum.c module.
  */
  
 /******************************************************************************
@@ -63,6 +79,7 @@
 /******************************************************************************
  * Forward references.
  ******************************************************************************/
+static uint32_t slowFletcher(const uint8_t* ptr, size_t len, uint32_t mod, uint32_t a);
  
 
 /******************************************************************************
@@ -91,6 +108,9 @@ static uint16_t testData2[] = {
     0x99AA, 0xBBCC, 0xDDEE, 0xFF00,
     0x0000};
 
+static uint8_t  testData3[2 + 16*sizeof(uint16_t)];
+static uint16_t testData4[129];
+
 /******************************************************************************
  * Public functions.
  ******************************************************************************/
@@ -136,6 +156,146 @@ void loop(void)
     cond &= TEST_ASSERT_FAIL((ipv4_checksum(testData2, 17*sizeof(uint16_t)) == 0));
     TEST_ASSERT_PASS(cond);
     
+    // An empty block sums to zero.
+    TEST_NUMBER(3);
+    TEST_ASSERT(ipv4_checksum(testData2, 0) == 0xFFFF);
+    
+    // An odd trailing byte is padded with a zero byte.
+    TEST_NUMBER(4);
+    memcpy(testData3, testData1, 16);
+    testData3[15] = 0;
+    TEST_ASSERT(ipv4_checksum(testData1, 15) == ipv4_checksum(testData3, 16));
+    
+    // Unaligned start.
+    TEST_NUMBER(5);
+    memcpy(testData3 + 1, testData2, 16*sizeof(uint16_t));
+    TEST_ASSERT(ipv4_checksum(testData3 + 1, 16*sizeof(uint16_t)) == cksm3);
+    
+    // A block long enough for the vector kernels, with worst-case carries.
+    TEST_NUMBER(6);
+    for (uint16_t i = 0; i < 128; i++)
+    {
+        testData4[i] = (i & 1) ? 0xFFFF : (uint16_t)(0xFF01 + i);
+    }
+    testData4[128] = ipv4_checksum(testData4, 128*sizeof(uint16_t));
+    TEST_ASSERT(ipv4_checksum(testData4, 129*sizeof(uint16_t)) == 0);
+    
+    // Incremental updates must match summing the block again.
+    TEST_NUMBER(7);
+    {
+        uint16_t old16 = testData2[3];
+        uint16_t new16 = 0x00FF;
+        uint32_t old32;
+        uint32_t new32 = 0xC0A80001;
+        uint8_t  oldBytes[6];
+        uint8_t  newBytes[6] = { 0xFF, 0xFF, 0x00, 0x00, 0x12, 0x34 };
+        uint16_t sum = cksm3;
+        
+        testData2[3] = new16;
+        sum = ipv4_checksum_update16(sum, old16, new16);
+        cond = TEST_ASSERT_FAIL((sum == ipv4_checksum(testData2, 16*sizeof(uint16_t))));
+        
+        memcpy(&old32, &testData2[4], sizeof(old32));
+        memcpy(&testData2[4], &new32, sizeof(new32));
+        sum = ipv4_checksum_update32(sum, old32, new32);
+        cond &= TEST_ASSERT_FAIL((sum == ipv4_checksum(testData2, 16*sizeof(uint16_t))));
+        
+        memcpy(oldBytes, &testData2[8], sizeof(oldBytes));
+        memcpy(&testData2[8], newBytes, sizeof(newBytes));
+        sum = ipv4_checksum_update(sum, oldBytes, newBytes, sizeof(newBytes));
+        cond &= TEST_ASSERT_FAIL((sum == ipv4_checksum(testData2, 16*sizeof(uint16_t))));
+        TEST_ASSERT_PASS(cond);
+    }
+    
+    // Pseudo-header checksums over an odd split of a 31 byte UDP datagram
+    // must match summing the pseudo-header and datagram laid out together.
+    TEST_NUMBER(8);
+    {
+        static uint8_t packet[40 + 31];
+        const uint8_t  src[16] = { 192, 168, 0, 31, 0xFE, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+        const uint8_t  dst[16] = { 192, 168, 0, 30, 0xFE, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2 };
+        const uint8_t* payload = (const uint8_t*)testData1;
+        struct iovec   iov[2];
+        
+        iov[0].iov_base = (void*)payload;
+        iov[0].iov_len  = 7;
+        iov[1].iov_base = (void*)(payload + 7);
+        iov[1].iov_len  = 24;
+        
+        memset(packet, 0, sizeof(packet));
+        memcpy(packet, src, 4);
+        memcpy(packet + 4, dst, 4);
+        packet[9]  = 17;
+        packet[11] = 31;
+        memcpy(packet + 12, payload, 31);
+        cond = TEST_ASSERT_FAIL((l4_checksum_v4(src, dst, 17, iov, 2) == ipv4_checksum(packet, 12 + 31)));
+        
+        memset(packet, 0, sizeof(packet));
+        memcpy(packet, src, 16);
+        memcpy(packet + 16, dst, 16);
+        packet[35] = 31;
+        packet[39] = 17;
+        memcpy(packet + 40, payload, 31);
+        cond &= TEST_ASSERT_FAIL((l4_checksum_v6(src, dst, 17, iov, 2) == ipv4_checksum(packet, 40 + 31)));
+        TEST_ASSERT_PASS(cond);
+    }
+    
+    // Copying with the sum must copy exactly the block, and sums of an odd
+    // split combined must give the checksum of the whole.
+    TEST_NUMBER(9);
+    {
+        const size_t len = 128*sizeof(uint16_t);
+        uint8_t* copy = (uint8_t*)testData4 + 1;
+        uint16_t sum;
+        
+        memset(testData4, 0, sizeof(testData4));
+        sum = ipv4_sum_copy(copy, testData3 + 1, 16*sizeof(uint16_t));
+        cond = TEST_ASSERT_FAIL((memcmp(copy, testData3 + 1, 16*sizeof(uint16_t)) == 0));
+        cond &= TEST_ASSERT_FAIL(((uint16_t)~sum == ipv4_checksum(testData3 + 1, 16*sizeof(uint16_t))));
+        cond &= TEST_ASSERT_FAIL((*(copy + 16*sizeof(uint16_t)) == 0));
+        
+        for (uint16_t i = 0; i < 128; i++)
+        {
+            testData4[i] = (uint16_t)(0x8000 + 257*i);
+        }
+        sum = ipv4_sum_combine(0, ipv4_sum_partial(testData4, 77), 0);
+        sum = ipv4_sum_combine(sum, ipv4_sum_partial((uint8_t*)testData4 + 77, len - 77), 77);
+        cond &= TEST_ASSERT_FAIL(((uint16_t)~sum == ipv4_checksum(testData4, len)));
+        TEST_ASSERT_PASS(cond);
+    }
+    
+    // The byte sum must not depend on the signedness of char, and must
+    // handle an empty block and blocks long enough for the vector kernels.
+    TEST_NUMBER(10);
+    {
+        uint8_t* bytes = (uint8_t*)testData4;
+        
+        for (uint16_t i = 0; i < 257; i++)
+        {
+            bytes[i] = (uint8_t)(0x80 + i);
+        }
+        cond = TEST_ASSERT_FAIL((checksum(bytes, 0) == 0));
+        bytes[257] = (uint8_t)checksum(bytes + 1, 256);
+        cond &= TEST_ASSERT_FAIL((checksum(bytes + 1, 257) == 0));
+        TEST_ASSERT_PASS(cond);
+    }
+    
+    // Check values, and the vector kernels against a byte at a time.
+    TEST_NUMBER(11);
+    {
+        const uint8_t* bytes = (const uint8_t*)testData4 + 1;
+        
+        cond = TEST_ASSERT_FAIL((fletcher16("abcde", 5) == 0xC8F0));
+        cond &= TEST_ASSERT_FAIL((fletcher16("abcdefgh", 8) == 0x0627));
+        cond &= TEST_ASSERT_FAIL((fletcher32("abcde", 5) == 0xF04FC729));
+        cond &= TEST_ASSERT_FAIL((fletcher32("abcdefgh", 8) == 0xEBE19591));
+        cond &= TEST_ASSERT_FAIL((adler32("Wikipedia", 9) == 0x11E60398));
+        cond &= TEST_ASSERT_FAIL((adler32(bytes, 0) == 1));
+        cond &= TEST_ASSERT_FAIL((fletcher16(bytes, 255) == (uint16_t)slowFletcher(bytes, 255, 255, 0)));
+        cond &= TEST_ASSERT_FAIL((adler32(bytes, 255) == slowFletcher(bytes, 255, 65521, 1)));
+        TEST_ASSERT_PASS(cond);
+    }
+    
     TEST_DONE();
 }
 
@@ -144,6 +304,20 @@ void loop(void)
  * Private functions.
  ******************************************************************************/
 
+/**************************************
+ * slowFletcher
+ **************************************/
+static uint32_t slowFletcher(const uint8_t* ptr, size_t len, uint32_t mod, uint32_t a)
+{
+    uint32_t b = 0;
+    
+    for (size_t i = 0; i < len; i++)
+    {
+        a = (a + ptr[i]) % mod;
+        b = (b + a) % mod;
+    }
+    return (b << ((mod > 255) ? 16 : 8)) | a;
+}
 
 
 /******************************************************************************
@@ -17,6 +17,9 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added a test of add() with a running CRC, if USE_FIFO_CRC is defined.
+ *
  * 10/07/2015 - Tom Kerr
  * Added support for automated unit testing over a serial port.
  *
@@ -35,7 +38,10 @@
  * Contains the setup() and loop() functions for the program.  Also uses the
  * aunit pseudo test framework to execute the tests.
  *
- * Copy aunit.cpp, aunit.h, Fifo.cpp and Fifo.h into your sketch folder.  
+ * Copy aunit.cpp, aunit.h, Fifo.cpp and Fifo.h into your sketch folder.
+ * To also test add() with a running CRC, uncomment #define USE_FIFO_CRC in
+ * Fifo.h and copy crc.c, crc.h and Iovec.h as well.  The Makefile builds
+ * with USE_FIFO_CRC defined.
  * This sketch tests all functions in the Fifo.cpp module.
  */
  
@@ -255,6 +261,48 @@ void loop(void)
     TestFifo.clear();
     TEST_ASSERT(TestFifo.count() == 0);
     
+#if defined(USE_FIFO_CRC)
+    // Add with a running CRC.  The CRC of the bytes added must match
+    // crcFast() of the same bytes, including adds that wrap the tail.
+    TEST_NUMBER(21); 
+    crcInit();
+    TestFifo.clear();
+    data_in = 0;
+    for (uint16_t j = 0; j < 1000; j++)
+    {
+        CRC_CTX ctx;
+        
+        for (i=0; i<group+1; i++)
+        {
+            dataBuf[i] = data_in++;
+        }
+        crc_init(&ctx);
+        pass = false;
+        TEST_ASSERT_BREAK2((TestFifo.add(dataBuf, group+1, &ctx) == group+1), j, 1);
+        TEST_ASSERT_BREAK2((crc_final(&ctx) == crcFast(dataBuf, group+1)), j, 2);
+        TEST_ASSERT_BREAK2((TestFifo.remove(dataBuf, group) == group), j, 3);
+        pass = true;
+        
+        // Drain the fifo when it fills.
+        if (TestFifo.available() < group+1)
+        {
+            TestFifo.clear();
+        }
+    }
+    TEST_ASSERT_PASS(pass);
+    
+    // Only the bytes that fit are included in the CRC.
+    TEST_NUMBER(22); 
+    {
+        CRC_CTX ctx;
+        
+        TestFifo.clear();
+        TestFifo.add(dataBuf, FIFO_SIZE - 2);
+        crc_init(&ctx);
+        TEST_ASSERT((TestFifo.add(dataBuf, group, &ctx) == 2) && (crc_final(&ctx) == crcFast(dataBuf, 2)));
+    }
+#endif
+    
     Serial.print("Test assertions: ");
     Serial.println(TEST_ASSERT_COUNT());
     
@@ -14,6 +14,9 @@
 #
 # Modification History:
 #
+# 10/18/2026 - Tom Kerr
+# Build with USE_FIFO_CRC and crc.o so the CRC add() tests run.
+#
 # 09/22/2015 - Tom Kerr
 # Refactored .ino build rule.
 #
@@ -68,7 +71,7 @@ SOURCEPATH = .
 
 # Toolset flags.
 CFLAGS  = -c -g -Os -Wall -fno-exceptions -ffunction-sections -fdata-sections -MMD -mmcu=$(CPU) &
-    -DF_CPU=$(F_CPU) -DARDUINO=$(ARDUINO_REV) -D$(CPU) -D$(BRD) -D$(ARCH)
+    -DF_CPU=$(F_CPU) -DARDUINO=$(ARDUINO_REV) -D$(CPU) -D$(BRD) -D$(ARCH) -DUSE_FIFO_CRC
 CCFLAGS = -fno-threadsafe-statics
 INOFLAGS = -x c++
 LDFLAGS = -Os -Wl,--gc-sections -mmcu=$(CPU)
@@ -79,6 +82,7 @@ OCFLAGS = --set-section-flags=.eeprom=alloc,load --no-change-warnings --change-s
 OBJS = &
    FifoTest.o &
    Fifo.o &
+   crc.o &
    aunit.o 
       
 all: $(TARGET).hex
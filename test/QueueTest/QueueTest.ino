@@ -17,6 +17,9 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added QUEUE_EnqueueBlock() tests, if USE_QUEUE_CRC is defined.
+ *
  * 10/07/2015 - Tom Kerr
  * Added support for automated unit testing over a serial port.
  *
@@ -40,6 +43,9 @@
  * UnionTypeDefs.h
  * aunit.cpp
  * aunit.h
+ * To also test QUEUE_EnqueueBlock(), uncomment #define USE_QUEUE_CRC in
+ * Queue.h and copy crc.c, crc.h and Iovec.h as well.  The Makefile builds
+ * with USE_QUEUE_CRC defined.
  * This sketch tests all functions in the Queue.c module.
  */
  
@@ -96,6 +102,10 @@ static QUEUE testQueue;
 static LARGE_DATA largeDataArray[QUEUE_SIZE];
 static QUEUE largeDataQueue;
 
+#if defined(USE_QUEUE_CRC)
+static long  blockData[QUEUE_SIZE + 5];
+#endif
+
 
 /******************************************************************************
  * Public functions.
@@ -614,7 +624,82 @@ void loop(void)
         TEST_ASSERT_BREAK1(cond, i);
     }
     TEST_ASSERT_PASS(cond);
-    //if (!cond) goto Done;
+    if (!cond) goto Done;
+    
+#if defined(USE_QUEUE_CRC)
+    // ************************************************************************
+    // * Test block enqueueing with a running CRC.
+    // ************************************************************************
+    
+    // Stream blocks through the queue so the tail wraps.  The CRC of each
+    // block must match crcFast() of the same data.
+    TEST_NUMBER(22);
+    crcInit();
+    QUEUE_Define(&testQueue, queueArray, QUEUE_SIZE, sizeof(long), 0);
+    k = 0;
+    for (i = 0; i < 1000; i++)
+    {
+        CRC_CTX ctx;
+        
+        for (j = 0; j < 5; j++)
+        {
+            blockData[j] = i * 5 + j;
+        }
+        crc_init(&ctx);
+        cond = (QUEUE_EnqueueBlock(&testQueue, blockData, 5, &ctx) == 5);
+        TEST_ASSERT_BREAK1(cond, i);
+        cond = (crc_final(&ctx) == crcFast((const uint8_t*)blockData, 5 * sizeof(long)));
+        TEST_ASSERT_BREAK1(cond, i);
+        
+        // Dequeue all but a few, in order.
+        while (QUEUE_Count(&testQueue) > 3)
+        {
+            cond = (QUEUE_Dequeue(&testQueue, &j) == 1) && (j == k++);
+            TEST_ASSERT_BREAK1(cond, i);
+        }
+        if (!cond) break;
+    }
+    TEST_ASSERT_PASS(cond);
+    if (!cond) goto Done;
+    
+    // A block larger than the free space is cut short, and only the data
+    // enqueued is in the CRC.
+    TEST_NUMBER(23);
+    {
+        CRC_CTX ctx;
+        
+        crc_init(&ctx);
+        cond  = TEST_ASSERT_FAIL(QUEUE_EnqueueBlock(&testQueue, blockData, QUEUE_SIZE, &ctx) == QUEUE_SIZE - 3);
+        cond &= TEST_ASSERT_FAIL(crc_final(&ctx) == crcFast((const uint8_t*)blockData, (QUEUE_SIZE - 3) * sizeof(long)));
+        cond &= TEST_ASSERT_FAIL(QUEUE_Count(&testQueue) == QUEUE_SIZE);
+        cond &= TEST_ASSERT_FAIL(QUEUE_EnqueueBlock(&testQueue, blockData, 1, NULL) == 0);
+    }
+    TEST_ASSERT_PASS(cond);
+    if (!cond) goto Done;
+    
+    // With overwrite, a block larger than the queue leaves its newest
+    // elements in the queue, and all of it in the CRC.
+    TEST_NUMBER(24);
+    {
+        CRC_CTX ctx;
+        
+        testQueue.overwrite = 1;
+        for (j = 0; j < QUEUE_SIZE + 5; j++)
+        {
+            blockData[j] = j;
+        }
+        crc_init(&ctx);
+        cond  = TEST_ASSERT_FAIL(QUEUE_EnqueueBlock(&testQueue, blockData, QUEUE_SIZE + 5, &ctx) == QUEUE_SIZE + 5);
+        cond &= TEST_ASSERT_FAIL(crc_final(&ctx) == crcFast((const uint8_t*)blockData, sizeof(blockData)));
+        cond &= TEST_ASSERT_FAIL(QUEUE_Count(&testQueue) == QUEUE_SIZE);
+        for (i = 5; cond && (i < QUEUE_SIZE + 5); i++)
+        {
+            cond = (QUEUE_Dequeue(&testQueue, &j) == 1) && (j == i);
+            TEST_ASSERT_BREAK1(cond, i);
+        }
+    }
+    TEST_ASSERT_PASS(cond);
+#endif
     
     // Done.  Print test statistics.
 Done:
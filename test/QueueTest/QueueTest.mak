@@ -14,6 +14,9 @@
 #
 # Modification History:
 #
+# 10/18/2026 - Tom Kerr
+# Build with USE_QUEUE_CRC and crc.o so the QUEUE_EnqueueBlock() tests run.
+#
 # 09/13/2015 - Tom Kerr
 # Initial creation.
 ##############################################################################
@@ -65,7 +68,7 @@ SOURCEPATH = .
 
 # Toolset flags.
 CFLAGS  = -c -g -Os -Wall -fno-exceptions -ffunction-sections -fdata-sections -MMD -mmcu=$(CPU) &
-    -DF_CPU=$(F_CPU) -DARDUINO=$(ARDUINO_REV) -D$(CPU) -D$(BRD) -D$(ARCH)
+    -DF_CPU=$(F_CPU) -DARDUINO=$(ARDUINO_REV) -D$(CPU) -D$(BRD) -D$(ARCH) -DUSE_QUEUE_CRC
 CCFLAGS = -fno-threadsafe-statics
 INOFLAGS = -x c++
 LDFLAGS = -Os -Wl,--gc-sections -mmcu=$(CPU)
@@ -76,6 +79,7 @@ OCFLAGS = --set-section-flags=.eeprom=alloc,load --no-change-warnings --change-s
 OBJS = &
    QueueTest.o &
    Queue.o &
+   crc.o &
    Checksum.o &
    aunit.o 
       
@@ -0,0 +1,192 @@
+/******************************************************************************
+ * crcBench.c
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Host benchmark for crcFast() and CRC16_Calc().
+ *
+ * Prints the throughput of each function at several message sizes, along
+ * with the RAM taken by its look-up tables, so the table variants selected
+ * by USE_CRC_NIBBLE, CRC_SLICE_BY, CRC16_USE_NIBBLE and CRC16_SLICE_BY can
+ * be compared.  The Makefile builds one program per variant.
+ *
+ * Both functions are checked against their standard check values before
+ * being timed.
+ */
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "crc.h"
+#include "Crc16.h"
+
+
+/******************************************************************************
+ * Local definitions.
+ ******************************************************************************/
+
+/** Name of the variant, set by the Makefile. */
+#if !defined(BENCH_VARIANT)
+#define BENCH_VARIANT "default"
+#endif
+
+/** Bytes processed per measurement, whatever the message size. */
+#define BENCH_TOTAL_BYTES (64UL * 1024 * 1024)
+
+/** Size of the largest message. */
+#define BENCH_MAX_SIZE (1024UL * 1024)
+
+static const size_t BenchSizes[] = { 16, 64, 1024, 64 * 1024, BENCH_MAX_SIZE };
+
+#define BENCH_NUM_SIZES (sizeof(BenchSizes) / sizeof(BenchSizes[0]))
+
+
+/******************************************************************************
+ * Local data.
+ ******************************************************************************/
+
+/** Defeats dead code elimination of the timed calls. */
+static volatile unsigned long BenchSink;
+
+
+/******************************************************************************
+ * Private functions.
+ ******************************************************************************/
+
+/**************************************
+ * BenchSeconds
+ **************************************/
+static double BenchSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+/**************************************
+ * BenchCrcFast
+ **************************************/
+static double BenchCrcFast(const uint8_t* buf, size_t size)
+{
+    size_t count = BENCH_TOTAL_BYTES / size;
+    size_t i;
+    crc_t  crc = 0;
+    double start;
+
+    start = BenchSeconds();
+    for (i = 0; i < count; i++)
+    {
+        crc ^= crcFast(buf, size);
+    }
+    BenchSink = (unsigned long)crc;
+
+    return (double)(count * size) / (BenchSeconds() - start);
+}
+
+
+/**************************************
+ * BenchCrc16
+ **************************************/
+static double BenchCrc16(const uint8_t* buf, size_t size)
+{
+    size_t   count = BENCH_TOTAL_BYTES / size;
+    size_t   i;
+    uint16_t crc = 0;
+    double   start;
+
+    start = BenchSeconds();
+    for (i = 0; i < count; i++)
+    {
+        crc ^= CRC16_Calc(buf, size);
+    }
+    BenchSink = crc;
+
+    return (double)(count * size) / (BenchSeconds() - start);
+}
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+/**************************************
+ * main
+ **************************************/
+int main(void)
+{
+    static const uint8_t check[] = "123456789";
+    uint8_t*             buf;
+    size_t               i;
+
+    crcInit();
+    CRC16_Init();
+
+    if (crcFast(check, 9) != CHECK_VALUE)
+    {
+        printf("%s: crcFast check value FAILED\n", BENCH_VARIANT);
+        return 1;
+    }
+    if (CRC16_Calc(check, 9) != 0xBB3D)
+    {
+        printf("%s: CRC16_Calc check value FAILED\n", BENCH_VARIANT);
+        return 1;
+    }
+
+    buf = (uint8_t*)malloc(BENCH_MAX_SIZE);
+    if (buf == NULL)
+    {
+        return 1;
+    }
+    srand(1);
+    for (i = 0; i < BENCH_MAX_SIZE; i++)
+    {
+        buf[i] = (uint8_t)rand();
+    }
+
+    printf("%-8s %-10s %-16s %7s", "variant", "function", "standard", "table");
+    for (i = 0; i < BENCH_NUM_SIZES; i++)
+    {
+        printf(" %9lu", (unsigned long)BenchSizes[i]);
+    }
+    printf("   (MB/s by message size)\n");
+
+    printf("%-8s %-10s %-16s %7lu", BENCH_VARIANT, "crcFast", CRC_NAME, (unsigned long)CRC_TABLE_BYTES);
+    for (i = 0; i < BENCH_NUM_SIZES; i++)
+    {
+        printf(" %9.1f", BenchCrcFast(buf, BenchSizes[i]) / 1e6);
+    }
+    printf("\n");
+
+    printf("%-8s %-10s %-16s %7lu", BENCH_VARIANT, "CRC16_Calc", "CRC-16", (unsigned long)CRC16_TABLE_BYTES);
+    for (i = 0; i < BENCH_NUM_SIZES; i++)
+    {
+        printf(" %9.1f", BenchCrc16(buf, BenchSizes[i]) / 1e6);
+    }
+    printf("\n");
+
+    free(buf);
+    return 0;
+}
+
+// End of file.
@@ -0,0 +1,334 @@
+/******************************************************************************
+ * crcCheck.c
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added the CRC16_CalcIov() check.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added the CRC16_Start(), CRC16_Update() and CRC16_Final() check.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Host check of the CRC functions that have no Arduino test.
+ *
+ * crcParallel() and crcParallelFile() are checked against crcFast() on one
+ * and several threads, for sizes below, at and around multiples of
+ * CRC_PARALLEL_MIN_CHUNK, and for an empty file.  CRC16_Combine() is
+ * checked against CRC16_Calc() of the two arrays concatenated, and a
+ * running CRC16_Start(), CRC16_Update() and CRC16_Final() and
+ * CRC16_CalcIov() against CRC16_Calc() of the whole array.
+ *
+ * Prints each failure and exits with 1 if there were any, else 0.  The
+ * Makefile builds one program per table variant.
+ */
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "crc.h"
+#include "Crc16.h"
+#include "CrcParallel.h"
+#include "ThreadPool.h"
+
+
+/******************************************************************************
+ * Local definitions.
+ ******************************************************************************/
+
+/** Name of the variant, set by the Makefile. */
+#if !defined(CHECK_VARIANT)
+#define CHECK_VARIANT "default"
+#endif
+
+/** Size of the test data. */
+#define CHECK_MAX_SIZE (20 * CRC_PARALLEL_MIN_CHUNK)
+
+/** Reports a failed check and counts it, with the size or split it failed at. */
+#define CHECK(cond, what, value) \
+    do { if (!(cond)) { CheckFail(what, __LINE__, (size_t)(value)); } } while (0)
+
+static const size_t ParallelSizes[] =
+{
+    0,
+    1,
+    CRC_PARALLEL_MIN_CHUNK - 1,
+    CRC_PARALLEL_MIN_CHUNK,
+    CRC_PARALLEL_MIN_CHUNK + 1,
+    2 * CRC_PARALLEL_MIN_CHUNK - 1,
+    2 * CRC_PARALLEL_MIN_CHUNK,
+    2 * CRC_PARALLEL_MIN_CHUNK + 1,
+    5 * CRC_PARALLEL_MIN_CHUNK + 12345,
+    CHECK_MAX_SIZE - 7,
+};
+
+#define CHECK_NUM_PARALLEL_SIZES (sizeof(ParallelSizes) / sizeof(ParallelSizes[0]))
+
+static const int ThreadCounts[] = { 1, 4 };
+
+#define CHECK_NUM_THREAD_COUNTS (sizeof(ThreadCounts) / sizeof(ThreadCounts[0]))
+
+
+/******************************************************************************
+ * Local data.
+ ******************************************************************************/
+
+/** Number of failed checks. */
+static int CheckFailures;
+
+
+/******************************************************************************
+ * Private functions.
+ ******************************************************************************/
+
+/**************************************
+ * CheckFail
+ **************************************/
+static void CheckFail(const char* what, int line, size_t value)
+{
+    printf("%s: line %d: %s FAILED at %lu\n", CHECK_VARIANT, line, what, (unsigned long)value);
+    CheckFailures++;
+}
+
+
+/**************************************
+ * CheckWriteFile
+ **************************************/
+static int CheckWriteFile(char* path, const uint8_t* buf, size_t size)
+{
+    FILE* fp;
+    int   fd;
+
+    fd = mkstemp(path);
+    if (fd < 0) return -1;
+
+    fp = fdopen(fd, "wb");
+    if (fp == NULL)
+    {
+        close(fd);
+        unlink(path);
+        return -1;
+    }
+    if ((size > 0) && (fwrite(buf, 1, size, fp) != size))
+    {
+        fclose(fp);
+        unlink(path);
+        return -1;
+    }
+    if (fclose(fp) != 0)
+    {
+        unlink(path);
+        return -1;
+    }
+    return 0;
+}
+
+
+/**************************************
+ * CheckParallel
+ **************************************/
+static void CheckParallel(const uint8_t* buf)
+{
+    THREADPOOL pool;
+    char       path[] = "crcCheck_XXXXXX";
+    crc_t      crc;
+    size_t     i;
+    size_t     t;
+
+    for (t = 0; t < CHECK_NUM_THREAD_COUNTS; t++)
+    {
+        if (THREADPOOL_Create(&pool, ThreadCounts[t]) != 0)
+        {
+            CHECK(0, "THREADPOOL_Create", 0);
+            return;
+        }
+
+        for (i = 0; i < CHECK_NUM_PARALLEL_SIZES; i++)
+        {
+            size_t size = ParallelSizes[i];
+            crc_t  expect = crcFast(buf, size);
+
+            CHECK(crcParallel(&pool, buf, size) == expect, "crcParallel", size);
+
+            // Every few sizes is enough for the file path, which maps the
+            // file and then runs the same code.
+            if ((i % 3) == 0)
+            {
+                strcpy(path, "crcCheck_XXXXXX");
+                if (CheckWriteFile(path, buf, size) != 0)
+                {
+                    CHECK(0, "writing the test file", size);
+                    continue;
+                }
+                crc = (crc_t)~expect;
+                CHECK((crcParallelFile(&pool, path, &crc) == 0) && (crc == expect), "crcParallelFile", size);
+                unlink(path);
+            }
+        }
+        CHECK(crcParallelFile(&pool, "crcCheck_missing", &crc) == -1, "crcParallelFile of a missing file", 0);
+
+        THREADPOOL_Destroy(&pool);
+    }
+}
+
+
+/**************************************
+ * CheckCrc16Combine
+ **************************************/
+static void CheckCrc16Combine(const uint8_t* buf)
+{
+    static const size_t sizes[] = { 0, 1, 2, 3, 7, 8, 15, 16, 17, 100, 1000, 65536, 1000003 };
+    size_t              a;
+    size_t              b;
+
+    for (a = 0; a < sizeof(sizes) / sizeof(sizes[0]); a++)
+    {
+        for (b = 0; b < sizeof(sizes) / sizeof(sizes[0]); b++)
+        {
+            size_t   sizeA = sizes[a];
+            size_t   sizeB = sizes[b];
+            uint16_t crcA  = CRC16_Calc(buf, sizeA);
+            uint16_t crcB  = CRC16_Calc(buf + sizeA, sizeB);
+
+            CHECK(CRC16_Combine(crcA, crcB, sizeB) == CRC16_Calc(buf, sizeA + sizeB), "CRC16_Combine", sizeA + sizeB);
+        }
+    }
+}
+
+
+/**************************************
+ * CheckCrc16Stream
+ **************************************/
+static void CheckCrc16Stream(const uint8_t* buf)
+{
+    static const size_t sizes[] = { 256, 1000 };
+    CRC16_CTX           ctx;
+    size_t              i;
+    size_t              piece;
+    size_t              pos;
+
+    // As crcTest test 6 for crc_update(): the array is fed in pieces of 1 to
+    // 32 bytes, the last piece short.
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        size_t   size   = sizes[i];
+        uint16_t expect = CRC16_Calc(buf, size);
+
+        for (piece = 1; piece <= 32; piece++)
+        {
+            CRC16_Start(&ctx);
+            for (pos = 0; pos < size; pos += piece)
+            {
+                CRC16_Update(&ctx, buf + pos, (size - pos < piece) ? (size - pos) : piece);
+            }
+            CHECK(CRC16_Final(&ctx) == expect, "CRC16_Update", piece);
+            CHECK(CRC16_Final(&ctx) == expect, "CRC16_Final twice", piece);
+        }
+    }
+
+    // Nothing fed, and an empty piece.
+    CRC16_Start(&ctx);
+    CHECK(CRC16_Final(&ctx) == CRC16_Calc(buf, 0), "CRC16_Final of nothing", 0);
+    CRC16_Update(&ctx, buf, 0);
+    CRC16_Update(&ctx, buf, 9);
+    CHECK(CRC16_Final(&ctx) == CRC16_Calc(buf, 9), "CRC16_Update of an empty piece", 9);
+}
+
+
+/**************************************
+ * CheckCrc16Iov
+ **************************************/
+static void CheckCrc16Iov(const uint8_t* buf)
+{
+    struct iovec iov[5];
+    uint16_t     expect = CRC16_Calc(buf, 256);
+    size_t       a;
+    size_t       b;
+
+    // As crcTest test 7 for crc_iov(): every way of cutting 256 bytes into
+    // three segments, with an empty segment between each pair.
+    for (a = 0; a <= 256; a++)
+    {
+        for (b = a; b <= 256; b++)
+        {
+            iov[0].iov_base = (void*)buf;
+            iov[0].iov_len  = a;
+            iov[1].iov_base = NULL;
+            iov[1].iov_len  = 0;
+            iov[2].iov_base = (void*)(buf + a);
+            iov[2].iov_len  = b - a;
+            iov[3].iov_base = (void*)(buf + b);
+            iov[3].iov_len  = 0;
+            iov[4].iov_base = (void*)(buf + b);
+            iov[4].iov_len  = 256 - b;
+            if (CRC16_CalcIov(iov, 5) != expect)
+            {
+                CHECK(0, "CRC16_CalcIov", a);
+                return;
+            }
+        }
+    }
+
+    // No segments, and only empty ones.
+    CHECK(CRC16_CalcIov(iov, 0) == CRC16_Calc(buf, 0), "CRC16_CalcIov of no segments", 0);
+    CHECK(CRC16_CalcIov(&iov[1], 1) == CRC16_Calc(buf, 0), "CRC16_CalcIov of an empty segment", 0);
+}
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+/**************************************
+ * main
+ **************************************/
+int main(void)
+{
+    uint8_t* buf;
+    size_t   i;
+
+    crcInit();
+    CRC16_Init();
+
+    buf = (uint8_t*)malloc(CHECK_MAX_SIZE);
+    if (buf == NULL)
+    {
+        return 1;
+    }
+    srand(1);
+    for (i = 0; i < CHECK_MAX_SIZE; i++)
+    {
+        buf[i] = (uint8_t)rand();
+    }
+
+    CheckParallel(buf);
+    CheckCrc16Combine(buf);
+    CheckCrc16Stream(buf);
+    CheckCrc16Iov(buf);
+
+    free(buf);
+    printf("%s: %s\n", CHECK_VARIANT, (CheckFailures == 0) ? "OK" : "FAILED");
+    return (CheckFailures == 0) ? 0 : 1;
+}
+
+// End of file.
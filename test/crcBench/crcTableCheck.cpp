@@ -0,0 +1,129 @@
+/******************************************************************************
+ * crcTableCheck.cpp
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Host check of Crc<...>::calc() over a list of segments (CrcTable.h).
+ *
+ * For each standard, every way of cutting a 256-byte array into three
+ * segments, with an empty segment between each pair, must give the same
+ * CRC as calc() of the whole array.  The check values of the standards are
+ * already checked at compile time by CrcTable.h.
+ *
+ * Prints each failure and exits with 1 if there were any, else 0.
+ */
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "CrcTable.h"
+
+
+/******************************************************************************
+ * Local definitions.
+ ******************************************************************************/
+
+/** Size of the test data. */
+#define CHECK_SIZE 256
+
+
+/******************************************************************************
+ * Local data.
+ ******************************************************************************/
+
+/** Number of failed checks. */
+static int CheckFailures;
+
+
+/******************************************************************************
+ * Private functions.
+ ******************************************************************************/
+
+/**************************************
+ * CheckIov
+ **************************************/
+template <typename CrcT>
+static void CheckIov(const char* name, const uint8_t* buf)
+{
+    struct iovec iov[5];
+    auto         expect = CrcT::calc(buf, CHECK_SIZE);
+
+    for (size_t a = 0; a <= CHECK_SIZE; a++)
+    {
+        for (size_t b = a; b <= CHECK_SIZE; b++)
+        {
+            iov[0].iov_base = const_cast<uint8_t*>(buf);
+            iov[0].iov_len  = a;
+            iov[1].iov_base = NULL;
+            iov[1].iov_len  = 0;
+            iov[2].iov_base = const_cast<uint8_t*>(buf + a);
+            iov[2].iov_len  = b - a;
+            iov[3].iov_base = const_cast<uint8_t*>(buf + b);
+            iov[3].iov_len  = 0;
+            iov[4].iov_base = const_cast<uint8_t*>(buf + b);
+            iov[4].iov_len  = CHECK_SIZE - b;
+            if (CrcT::calc(iov, 5) != expect)
+            {
+                printf("%s: calc() of segments FAILED at %lu, %lu\n", name, (unsigned long)a, (unsigned long)b);
+                CheckFailures++;
+                return;
+            }
+        }
+    }
+
+    // No segments, and only empty ones.
+    if ((CrcT::calc(iov, 0) != CrcT::calc(buf, 0)) || (CrcT::calc(&iov[1], 1) != CrcT::calc(buf, 0)))
+    {
+        printf("%s: calc() of no data FAILED\n", name);
+        CheckFailures++;
+    }
+}
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+/**************************************
+ * main
+ **************************************/
+int main(void)
+{
+    uint8_t buf[CHECK_SIZE];
+
+    srand(1);
+    for (size_t i = 0; i < CHECK_SIZE; i++)
+    {
+        buf[i] = static_cast<uint8_t>(rand());
+    }
+
+    CheckIov<CrcCcitt>("CRC-CCITT", buf);
+    CheckIov<Crc16>("CRC-16", buf);
+    CheckIov<Crc32>("CRC-32", buf);
+    CheckIov<Crc32c>("CRC-32C", buf);
+    CheckIov<Crc64Ecma>("CRC-64/ECMA-182", buf);
+    CheckIov<Crc64Xz>("CRC-64/XZ", buf);
+
+    printf("CrcTable: %s\n", (CheckFailures == 0) ? "OK" : "FAILED");
+    return (CheckFailures == 0) ? 0 : 1;
+}
+
+// End of file.
@@ -17,6 +17,24 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_patch test.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_iov test.
+ *
+ * 10/18/2026 - Tom Kerr
+ * PrintCrc handles the CRC-32C and CRC-64 standards.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added streaming (crc_init/crc_update/crc_final) test.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_combine test.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Verify crcFast against crcSlow for every message length (slicing-by-N).
+ *
  * 10/07/2015 - Tom Kerr
  * Added support for automated unit testing over a serial port.
  *
@@ -33,7 +51,7 @@
  * aunit pseudo test framework to execute the tests.
  *
  * Copy the following files into your sketch folder:
- *    aunit.cpp, aunit.h, hex.c, hex.h, UnionTypeDefs.h, crc.c, crc.h
+ *    aunit.cpp, aunit.h, hex.c, hex.h, UnionTypeDefs.h, crc.c, crc.h, Iovec.h
  * This sketch tests all functions in the crc.c module.
  */
  
@@ -90,7 +108,9 @@
 void PrintCrc(crc_t crc)
 {
     char  crcHex[sizeof(crc_t)*2+1];
-    #if defined(CRC32)
+    #if defined(CRC64_ECMA) || defined(CRC64_XZ)
+        HEX_Uint64ToHex(crc, crcHex);
+    #elif defined(CRC32) || defined(CRC32C)
         HEX_Uint32ToHex(crc, crcHex);
     #else
         HEX_Uint16ToHex(crc, crcHex);
@@ -116,6 +136,9 @@ void loop(void)
     uint8_t  testVector[] = "123456789";
     uint8_t  longMessage[256];
     crc_t    crc;
+    crc_t    slowCrc;
+    CRC_CTX  ctx;
+    bool     cond;
     uint32_t start;
     uint32_t stop;
 
@@ -153,9 +176,9 @@ void loop(void)
         longMessage[i] = (uint8_t)i;
     }
     start = millis();
-    crc = crcSlow(longMessage, 256);
+    slowCrc = crcSlow(longMessage, 256);
     stop = millis();
-    PrintCrc(crc);
+    PrintCrc(slowCrc);
     Serial.print(F("Slow: "));
     Serial.print(stop-start);
     Serial.println(F(" ms"));
@@ -167,6 +190,87 @@ void loop(void)
     Serial.print(F("Fast: "));
     Serial.print(stop-start);
     Serial.println(F(" ms"));
+    TEST_ASSERT(crc == slowCrc);
+    
+    TEST_NUMBER(4);
+    Serial.println(F(CRC_NAME));
+    Serial.println(F("Fast == Slow, all offsets and lengths"));
+    cond = true;
+    for (uint16_t offset = 0; offset < 16; offset++)
+    {
+        for (uint16_t len = 0; len <= 256 - offset; len++)
+        {
+            cond &= TEST_ASSERT_FAIL((crcFast(longMessage + offset, len) == crcSlow(longMessage + offset, len)));
+            if (!cond) break;
+        }
+    }
+    TEST_ASSERT_PASS(cond);
+    
+    TEST_NUMBER(5);
+    Serial.println(F(CRC_NAME));
+    Serial.println(F("crc_combine, every split point"));
+    cond = true;
+    for (uint16_t split = 0; split <= 256; split++)
+    {
+        crc = crc_combine(crcFast(longMessage, split), crcFast(longMessage + split, 256 - split), 256 - split);
+        cond &= TEST_ASSERT_FAIL((crc == slowCrc));
+        if (!cond) break;
+    }
+    TEST_ASSERT_PASS(cond);
+    
+    TEST_NUMBER(6);
+    Serial.println(F(CRC_NAME));
+    Serial.println(F("crc_init/crc_update/crc_final, piece sizes 1 to 32"));
+    cond = true;
+    for (uint16_t piece = 1; piece <= 32; piece++)
+    {
+        crc_init(&ctx);
+        for (uint16_t pos = 0; pos < 256; pos += piece)
+        {
+            crc_update(&ctx, longMessage + pos, (256 - pos < piece) ? (256 - pos) : piece);
+        }
+        cond &= TEST_ASSERT_FAIL((crc_final(&ctx) == slowCrc));
+        if (!cond) break;
+    }
+    TEST_ASSERT_PASS(cond);
+    
+    TEST_NUMBER(7);
+    Serial.println(F(CRC_NAME));
+    Serial.println(F("crc_iov, three segments, every split"));
+    cond = true;
+    for (uint16_t split = 0; split <= 256; split++)
+    {
+        struct iovec iov[3];
+        
+        // Header, payload and an empty trailer.
+        iov[0].iov_base = longMessage;
+        iov[0].iov_len  = split;
+        iov[1].iov_base = longMessage + split;
+        iov[1].iov_len  = 256 - split;
+        iov[2].iov_base = longMessage;
+        iov[2].iov_len  = 0;
+        cond &= TEST_ASSERT_FAIL((crc_iov(iov, 3) == slowCrc));
+        if (!cond) break;
+    }
+    TEST_ASSERT_PASS(cond);
+    
+    TEST_NUMBER(8);
+    Serial.println(F(CRC_NAME));
+    Serial.println(F("crc_patch, 4 byte stamp at every offset"));
+    cond = true;
+    for (uint16_t offset = 0; offset <= 256 - 4; offset++)
+    {
+        uint8_t oldStamp[4];
+        uint8_t newStamp[4] = { 0xDE, 0xAD, 0xBE, (uint8_t)offset };
+        
+        memcpy(oldStamp, longMessage + offset, 4);
+        memcpy(longMessage + offset, newStamp, 4);
+        crc = crc_patch(slowCrc, 256, offset, oldStamp, newStamp, 4);
+        cond &= TEST_ASSERT_FAIL((crc == crcSlow(longMessage, 256)));
+        memcpy(longMessage + offset, oldStamp, 4);
+        if (!cond) break;
+    }
+    TEST_ASSERT_PASS(cond);
     
     TEST_DONE();
 }
@@ -0,0 +1,341 @@
+/******************************************************************************
+ * merkleHash.c
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added -u to time and check leaf updates.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Host program that prints the SHA-256 Merkle tree root of files.
+ *
+ * Usage: merkleHash [-l leafSize] [-t threads] [-p leaf] [-v] [-u count] file...
+ *
+ * Prints the root of each file in the format of sha256sum, and the leaf
+ * count and throughput on stderr.  -p prints the proof path of a leaf, and
+ * -v reads every leaf back and checks it against the root with its proof
+ * path.  -u changes count random leaves of a copy of the file in memory,
+ * one at a time and then as a batch, times the updates of the tree, and
+ * checks the root against a rebuild.  Exits with 0 on success, 1 if a leaf
+ * failed to verify or an updated root was wrong, and 2 if a file could not
+ * be read.
+ */
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "Merkle.h"
+
+
+/******************************************************************************
+ * Local definitions.
+ ******************************************************************************/
+
+/**
+ * @brief
+ * Leaf size used unless -l is given.
+ */
+#define DEFAULT_LEAF_SIZE (1024 * 1024)
+
+
+/******************************************************************************
+ * Private functions.
+ ******************************************************************************/
+
+/**************************************
+ * HashSeconds
+ **************************************/
+static double HashSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+/**************************************
+ * HashPrint
+ **************************************/
+static void HashPrint(const uint8_t digest[SHA256_BLOCK_SIZE])
+{
+    int i;
+    for (i = 0; i < SHA256_BLOCK_SIZE; i++)
+    {
+        printf("%02x", digest[i]);
+    }
+}
+
+
+/**************************************
+ * HashVerify
+ *
+ * Reads every leaf of a file and checks it against the root of its tree.
+ * Returns the number of leaves that failed, or -1 if the file could not
+ * be read.
+ **************************************/
+static long HashVerify(const MERKLE_TREE* tree, const char* path)
+{
+    uint8_t proof[MERKLE_MAX_LEVELS - 1][SHA256_BLOCK_SIZE];
+    uint8_t* leaf;
+    FILE*    file;
+    size_t   len;
+    size_t   i;
+    long     failed = 0;
+    int      n;
+
+    leaf = (uint8_t*)malloc(tree->leafSize);
+    file = fopen(path, "rb");
+    if ((leaf == NULL) || (file == NULL))
+    {
+        free(leaf);
+        if (file != NULL) fclose(file);
+        return -1;
+    }
+
+    for (i = 0; i < tree->numLeaves; i++)
+    {
+        len = fread(leaf, 1, tree->leafSize, file);
+        n   = MERKLE_Proof(tree, i, proof);
+        if (!MERKLE_Verify(MERKLE_Root(tree), tree->numLeaves, i, leaf, len, proof, n))
+        {
+            printf("%s: leaf %lu failed\n", path, (unsigned long)i);
+            failed++;
+        }
+    }
+
+    free(leaf);
+    fclose(file);
+    return failed;
+}
+
+
+/**************************************
+ * HashUpdates
+ *
+ * Changes count random leaves of a copy of a file, updates its tree with
+ * MERKLE_Update() and then with MERKLE_SetLeaf() and MERKLE_Commit(), and
+ * checks the roots against trees built from scratch.  Returns 0 if the
+ * roots matched, 1 if not, or -1 if the file could not be read.
+ **************************************/
+static int HashUpdates(THREADPOOL* pool, MERKLE_TREE* tree, const char* path, long count)
+{
+    MERKLE_TREE rebuilt;
+    uint8_t*    data;
+    FILE*       file;
+    size_t      leaf;
+    long        i;
+    int         pass;
+    int         status = 0;
+    double      start;
+    double      seconds[2];
+
+    data = (uint8_t*)malloc(tree->len + 1);
+    file = fopen(path, "rb");
+    if ((data == NULL) || (file == NULL) || (fread(data, 1, tree->len, file) != tree->len))
+    {
+        free(data);
+        if (file != NULL) fclose(file);
+        return -1;
+    }
+    fclose(file);
+
+    srand(1);
+    for (pass = 0; pass < 2; pass++)
+    {
+        start = HashSeconds();
+        for (i = 0; i < count; i++)
+        {
+            leaf = (size_t)rand() % tree->numLeaves;
+            data[leaf * tree->leafSize] ^= 0x5A;
+            if (pass == 0)
+            {
+                MERKLE_Update(tree, leaf, data + leaf * tree->leafSize);
+            }
+            else if (MERKLE_SetLeaf(tree, leaf, data + leaf * tree->leafSize) != 0)
+            {
+                status = -1;
+            }
+        }
+        MERKLE_Commit(tree);
+        seconds[pass] = HashSeconds() - start;
+
+        if ((MERKLE_Build(pool, &rebuilt, data, tree->len, tree->leafSize) != 0) ||
+            (memcmp(MERKLE_Root(tree), MERKLE_Root(&rebuilt), SHA256_BLOCK_SIZE) != 0))
+        {
+            status = 1;
+        }
+        MERKLE_Free(&rebuilt);
+    }
+
+    printf("%s: %ld leaves updated, %.2f us each one at a time, %.2f us each batched, %s\n",
+           path, count, seconds[0] / count * 1e6, seconds[1] / count * 1e6,
+           (status == 0) ? "roots match" : "ROOTS DIFFER");
+
+    free(data);
+    return (status < 0) ? -1 : status;
+}
+
+
+/**************************************
+ * HashUsage
+ **************************************/
+static int HashUsage(void)
+{
+    fprintf(stderr, "usage: merkleHash [-l leafSize] [-t threads] [-p leaf] [-v] [-u count] file...\n");
+    return 2;
+}
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+/**************************************
+ * main
+ **************************************/
+int main(int argc, char* argv[])
+{
+    uint8_t     proof[MERKLE_MAX_LEVELS - 1][SHA256_BLOCK_SIZE];
+    THREADPOOL  pool;
+    MERKLE_TREE tree;
+    size_t      leafSize = DEFAULT_LEAF_SIZE;
+    long        proofLeaf = -1;
+    long        updates   = 0;
+    long        failed;
+    int         verify  = 0;
+    int         threads = 0;
+    int         status  = 0;
+    int         i;
+    int         j;
+    int         n;
+    double      start;
+    double      seconds;
+
+    for (i = 1; (i < argc) && (argv[i][0] == '-'); i++)
+    {
+        if ((strcmp(argv[i], "-l") == 0) && (i + 1 < argc))
+        {
+            leafSize = (size_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+        {
+            threads = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-p") == 0) && (i + 1 < argc))
+        {
+            proofLeaf = atol(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-u") == 0) && (i + 1 < argc))
+        {
+            updates = atol(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-v") == 0)
+        {
+            verify = 1;
+        }
+        else
+        {
+            return HashUsage();
+        }
+    }
+    if ((i == argc) || (leafSize == 0)) return HashUsage();
+
+    if (THREADPOOL_Create(&pool, threads) != 0)
+    {
+        fprintf(stderr, "merkleHash: cannot create threads\n");
+        return 2;
+    }
+
+    for (; i < argc; i++)
+    {
+        start = HashSeconds();
+        if (MERKLE_BuildFile(&pool, &tree, argv[i], leafSize) != 0)
+        {
+            fprintf(stderr, "%s: cannot read\n", argv[i]);
+            status = 2;
+            continue;
+        }
+        seconds = HashSeconds() - start;
+
+        HashPrint(MERKLE_Root(&tree));
+        printf("  %s\n", argv[i]);
+
+        fprintf(stderr, "%s: %lu leaves, %.3f s, %.2f GB/s on %d threads\n", argv[i],
+                (unsigned long)tree.numLeaves, seconds,
+                (seconds > 0) ? tree.len / seconds / 1e9 : 0.0, THREADPOOL_Size(&pool));
+
+        if (proofLeaf >= 0)
+        {
+            n = MERKLE_Proof(&tree, (size_t)proofLeaf, proof);
+            if (n < 0)
+            {
+                fprintf(stderr, "%s: no leaf %ld\n", argv[i], proofLeaf);
+                status = 2;
+            }
+            for (j = 0; j < n; j++)
+            {
+                HashPrint(proof[j]);
+                printf("\n");
+            }
+        }
+
+        if (verify)
+        {
+            failed = HashVerify(&tree, argv[i]);
+            if (failed < 0)
+            {
+                fprintf(stderr, "%s: cannot read\n", argv[i]);
+                status = 2;
+            }
+            else if (failed > 0)
+            {
+                if (status == 0) status = 1;
+            }
+            else
+            {
+                printf("%s: %lu leaves verified\n", argv[i], (unsigned long)tree.numLeaves);
+            }
+        }
+
+        if (updates > 0)
+        {
+            n = HashUpdates(&pool, &tree, argv[i], updates);
+            if (n < 0)
+            {
+                fprintf(stderr, "%s: cannot read\n", argv[i]);
+                status = 2;
+            }
+            else if ((n > 0) && (status == 0))
+            {
+                status = 1;
+            }
+        }
+
+        MERKLE_Free(&tree);
+    }
+
+    THREADPOOL_Destroy(&pool);
+    return status;
+}
+
+// End of file.
@@ -0,0 +1,156 @@
+/******************************************************************************
+ * pcapCheck.c
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Host program that verifies the IPv4 header, TCP and UDP checksums of
+ * every packet in pcap and pcapng capture files.
+ *
+ * Usage: pcapCheck [-q] [-t threads] file...
+ *
+ * Prints each packet with a bad checksum (unless -q), then the counts and
+ * the throughput for each file.  Exits with 0 if every checksum verified,
+ * 1 if any was wrong, and 2 if a file could not be read.
+ */
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "PcapCheck.h"
+
+
+/******************************************************************************
+ * Private functions.
+ ******************************************************************************/
+
+/**************************************
+ * CheckSeconds
+ **************************************/
+static double CheckSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+/**************************************
+ * CheckReport
+ **************************************/
+static void CheckReport(void* arg, uint64_t packet, uint64_t offset, int flags)
+{
+    printf("%s: packet %llu at offset %llu: bad%s%s%s\n", (const char*)arg,
+           (unsigned long long)packet, (unsigned long long)offset,
+           (flags & PCAPCHECK_BAD_IPV4) ? " ipv4" : "",
+           (flags & PCAPCHECK_BAD_TCP)  ? " tcp"  : "",
+           (flags & PCAPCHECK_BAD_UDP)  ? " udp"  : "");
+}
+
+
+/**************************************
+ * CheckUsage
+ **************************************/
+static int CheckUsage(void)
+{
+    fprintf(stderr, "usage: pcapCheck [-q] [-t threads] file...\n");
+    return 2;
+}
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+/**************************************
+ * main
+ **************************************/
+int main(int argc, char* argv[])
+{
+    THREADPOOL      pool;
+    PCAPCHECK_STATS stats;
+    int             quiet   = 0;
+    int             threads = 0;
+    int             status  = 0;
+    int             i;
+    double          start;
+    double          seconds;
+
+    for (i = 1; (i < argc) && (argv[i][0] == '-'); i++)
+    {
+        if (strcmp(argv[i], "-q") == 0)
+        {
+            quiet = 1;
+        }
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+        {
+            threads = atoi(argv[++i]);
+        }
+        else
+        {
+            return CheckUsage();
+        }
+    }
+    if (i == argc) return CheckUsage();
+
+    if (THREADPOOL_Create(&pool, threads) != 0)
+    {
+        fprintf(stderr, "pcapCheck: cannot create threads\n");
+        return 2;
+    }
+
+    for (; i < argc; i++)
+    {
+        start = CheckSeconds();
+        if (PCAPCHECK_File(&pool, argv[i], &stats, quiet ? NULL : CheckReport, argv[i]) != 0)
+        {
+            fprintf(stderr, "%s: not a readable pcap or pcapng capture\n", argv[i]);
+            status = 2;
+            continue;
+        }
+        seconds = CheckSeconds() - start;
+
+        printf("%s: %llu packets, %llu bytes%s\n", argv[i],
+               (unsigned long long)stats.packets, (unsigned long long)stats.bytes,
+               stats.truncated ? ", last record truncated" : "");
+        printf("verified: ipv4 %llu, tcp %llu, udp %llu\n",
+               (unsigned long long)stats.ipv4, (unsigned long long)stats.tcp,
+               (unsigned long long)stats.udp);
+        printf("bad: ipv4 %llu, tcp %llu, udp %llu\n",
+               (unsigned long long)stats.ipv4Bad, (unsigned long long)stats.tcpBad,
+               (unsigned long long)stats.udpBad);
+        printf("skipped: %llu\n", (unsigned long long)stats.skipped);
+        printf("time: %.3f s, %.2f GB/s on %d threads\n",
+               seconds, (seconds > 0) ? stats.bytes / seconds / 1e9 : 0.0, THREADPOOL_Size(&pool));
+
+        if ((status == 0) && (stats.ipv4Bad + stats.tcpBad + stats.udpBad != 0))
+        {
+            status = 1;
+        }
+    }
+
+    THREADPOOL_Destroy(&pool);
+    return status;
+}
+
+// End of file.
@@ -0,0 +1,425 @@
+/******************************************************************************
+ * pcapGen.c
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Host program that writes a synthetic capture for testing pcapCheck.
+ *
+ * Usage: pcapGen [-n] [-s] [-c count] [-b every] file
+ *
+ *   -n        Write pcapng instead of pcap.
+ *   -s        Write the opposite byte order to the host's.
+ *   -c count  Number of packets (default 10000).
+ *   -b every  Corrupt a checksum in one packet of every this many (default
+ *             7; 0 for none).
+ *
+ * The packets cycle through IPv4 TCP and UDP, IPv6 TCP behind an 802.1Q
+ * tag, IPv6 UDP behind a hop-by-hop options header, IPv4 UDP without a
+ * checksum, an IPv4 fragment, a TCP segment cut short by the snapshot
+ * length, and ARP.  Payloads have random lengths, odd and even.
+ *
+ * Checksums are computed here with a plain RFC 1071 sum, independently of
+ * Checksum.c.  The counts pcapCheck should print are written to standard
+ * output in its format, for comparison.
+ */
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+/******************************************************************************
+ * Local definitions.
+ ******************************************************************************/
+
+/** Largest payload generated. */
+#define GEN_MAX_PAYLOAD 1460
+
+/** Bytes captured of a packet cut short by the snapshot length. */
+#define GEN_SNAP_SHORT 44
+
+/** Packet kinds, in the order they are generated. */
+enum
+{
+    GEN_IPV4_TCP,
+    GEN_IPV4_UDP,
+    GEN_IPV6_VLAN_TCP,
+    GEN_IPV6_HOP_UDP,
+    GEN_IPV4_UDP_NOSUM,
+    GEN_IPV4_FRAGMENT,
+    GEN_IPV4_TCP_SHORT,
+    GEN_ARP,
+    GEN_NUM_KINDS
+};
+
+/** Expected counts. */
+typedef struct
+{
+    unsigned long ipv4;
+    unsigned long ipv4Bad;
+    unsigned long tcp;
+    unsigned long tcpBad;
+    unsigned long udp;
+    unsigned long udpBad;
+    unsigned long skipped;
+} GEN_COUNTS;
+
+
+/******************************************************************************
+ * Local data.
+ ******************************************************************************/
+
+static FILE*    GenFile;
+static int      GenBigEndian;
+static uint32_t GenRandom = 2463534242u;
+
+
+/******************************************************************************
+ * Private functions.
+ ******************************************************************************/
+
+/**************************************
+ * GenNext
+ **************************************/
+static uint32_t GenNext(void)
+{
+    // xorshift32, so the capture is the same on every host.
+    GenRandom ^= GenRandom << 13;
+    GenRandom ^= GenRandom >> 17;
+    GenRandom ^= GenRandom << 5;
+    return GenRandom;
+}
+
+
+/**************************************
+ * GenPut16 / GenPut32
+ **************************************/
+static void GenPut16(uint16_t value)
+{
+    uint8_t b[2];
+    b[GenBigEndian ? 1 : 0] = (uint8_t)value;
+    b[GenBigEndian ? 0 : 1] = (uint8_t)(value >> 8);
+    fwrite(b, 1, 2, GenFile);
+}
+
+static void GenPut32(uint32_t value)
+{
+    GenPut16((uint16_t)(GenBigEndian ? (value >> 16) : value));
+    GenPut16((uint16_t)(GenBigEndian ? value : (value >> 16)));
+}
+
+
+/**************************************
+ * GenBe16
+ **************************************/
+static void GenBe16(uint8_t* ptr, uint32_t value)
+{
+    ptr[0] = (uint8_t)(value >> 8);
+    ptr[1] = (uint8_t)value;
+}
+
+
+/**************************************
+ * GenSum
+ **************************************/
+static uint32_t GenSum(uint32_t sum, const uint8_t* ptr, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i + 1 < len; i += 2)
+    {
+        sum += (uint32_t)((ptr[i] << 8) | ptr[i + 1]);
+    }
+    if (len & 1)
+    {
+        sum += (uint32_t)ptr[len - 1] << 8;
+    }
+    return sum;
+}
+
+
+/**************************************
+ * GenFinish
+ **************************************/
+static uint16_t GenFinish(uint32_t sum)
+{
+    while (sum >> 16)
+    {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return (uint16_t)~sum;
+}
+
+
+/**************************************
+ * GenL4
+ **************************************/
+static void GenL4(uint8_t* ip, int ipv6, uint8_t proto, uint8_t* seg, size_t len)
+{
+    uint32_t sum;
+    uint16_t check;
+    size_t   at = (proto == 6) ? 16 : 6;
+
+    sum = ipv6 ? GenSum(0, ip + 8, 32) : GenSum(0, ip + 12, 8);
+    sum += proto + (uint32_t)len;
+    seg[at] = seg[at + 1] = 0;
+    check = GenFinish(GenSum(sum, seg, len));
+    if ((proto == 17) && (check == 0)) check = 0xFFFF;
+    GenBe16(seg + at, check);
+}
+
+
+/**************************************
+ * GenRecord
+ **************************************/
+static void GenRecord(int pcapng, const uint8_t* pkt, uint32_t capLen, uint32_t origLen, uint32_t n)
+{
+    static const uint8_t pad[4] = { 0, 0, 0, 0 };
+    uint32_t padLen = (4 - (capLen & 3)) & 3;
+
+    if (pcapng)
+    {
+        GenPut32(6);
+        GenPut32(32 + capLen + padLen);
+        GenPut32(0);
+        GenPut32(0);
+        GenPut32(n);
+        GenPut32(capLen);
+        GenPut32(origLen);
+        fwrite(pkt, 1, capLen, GenFile);
+        fwrite(pad, 1, padLen, GenFile);
+        GenPut32(32 + capLen + padLen);
+    }
+    else
+    {
+        GenPut32(n / 1000);
+        GenPut32((n % 1000) * 1000);
+        GenPut32(capLen);
+        GenPut32(origLen);
+        fwrite(pkt, 1, capLen, GenFile);
+    }
+}
+
+
+/**************************************
+ * GenPacket
+ **************************************/
+static void GenPacket(int pcapng, uint32_t n, int corrupt, GEN_COUNTS* counts)
+{
+    static uint8_t pkt[14 + 4 + 40 + 8 + 20 + GEN_MAX_PAYLOAD];
+    int      kind = (int)(n % GEN_NUM_KINDS);
+    size_t   payload = GenNext() % (GEN_MAX_PAYLOAD + 1);
+    size_t   eth = 14;
+    size_t   ipLen;
+    size_t   l4Len;
+    size_t   len;
+    uint8_t* ip;
+    uint8_t* seg;
+    uint8_t  proto;
+    size_t   i;
+
+    memset(pkt, 0, sizeof(pkt));
+    memset(pkt, 0x02, 6);
+    memset(pkt + 6, 0x04, 6);
+
+    if (kind == GEN_ARP)
+    {
+        GenBe16(pkt + 12, 0x0806);
+        for (i = 14; i < 42; i++) pkt[i] = (uint8_t)GenNext();
+        GenRecord(pcapng, pkt, 60, 60, n);
+        counts->skipped++;
+        return;
+    }
+
+    if (kind == GEN_IPV6_VLAN_TCP)
+    {
+        GenBe16(pkt + 12, 0x8100);
+        GenBe16(pkt + 14, 100);
+        eth = 18;
+    }
+    ip = pkt + eth;
+
+    proto = ((kind == GEN_IPV4_TCP) || (kind == GEN_IPV6_VLAN_TCP) ||
+             (kind == GEN_IPV4_FRAGMENT) || (kind == GEN_IPV4_TCP_SHORT)) ? 6 : 17;
+    l4Len = ((proto == 6) ? 20 : 8) + payload;
+
+    if ((kind == GEN_IPV6_VLAN_TCP) || (kind == GEN_IPV6_HOP_UDP))
+    {
+        size_t ext = (kind == GEN_IPV6_HOP_UDP) ? 8 : 0;
+
+        GenBe16(pkt + eth - 2, 0x86DD);
+        ip[0] = 0x60;
+        GenBe16(ip + 4, (uint32_t)(ext + l4Len));
+        ip[6] = ext ? 0 : proto;
+        ip[7] = 64;
+        for (i = 8; i < 40; i++) ip[i] = (uint8_t)GenNext();
+        if (ext)
+        {
+            ip[40] = proto;
+            ip[41] = 0;
+            ip[42] = 1;  // PadN option filling the header
+            ip[43] = 4;
+        }
+        ipLen = 40 + ext;
+    }
+    else
+    {
+        GenBe16(pkt + 12, 0x0800);
+        ip[0] = 0x45;
+        GenBe16(ip + 2, (uint32_t)(20 + l4Len));
+        GenBe16(ip + 4, n);
+        if (kind == GEN_IPV4_FRAGMENT) GenBe16(ip + 6, 0x2000);
+        ip[8] = 64;
+        ip[9] = proto;
+        for (i = 12; i < 20; i++) ip[i] = (uint8_t)GenNext();
+        ipLen = 20;
+    }
+
+    seg = ip + ipLen;
+    for (i = 0; i < l4Len; i++) seg[i] = (uint8_t)GenNext();
+    if (proto == 17) GenBe16(seg + 4, (uint32_t)l4Len);
+
+    if (kind == GEN_IPV4_UDP_NOSUM)
+    {
+        seg[6] = seg[7] = 0;
+    }
+    else
+    {
+        GenL4(ip, ip[0] == 0x60, proto, seg, l4Len);
+    }
+    if (ip[0] == 0x45)
+    {
+        GenBe16(ip + 10, GenFinish(GenSum(0, ip, 20)));
+        counts->ipv4++;
+    }
+
+    // What pcapCheck can verify.
+    if ((kind == GEN_IPV4_TCP) || (kind == GEN_IPV6_VLAN_TCP)) counts->tcp++;
+    if ((kind == GEN_IPV4_UDP) || (kind == GEN_IPV6_HOP_UDP)) counts->udp++;
+
+    if (corrupt)
+    {
+        // A changed TTL breaks only the IPv4 header checksum, and a changed
+        // payload byte only the TCP or UDP checksum.
+        if ((ip[0] == 0x45) && ((kind != GEN_IPV4_TCP && kind != GEN_IPV4_UDP) || ((n / GEN_NUM_KINDS) & 1)))
+        {
+            ip[8]++;
+            counts->ipv4Bad++;
+        }
+        else
+        {
+            seg[0] ^= 0x5A;
+            if (proto == 6) counts->tcpBad++;
+            else counts->udpBad++;
+        }
+    }
+
+    len = eth + ipLen + l4Len;
+    if (kind == GEN_IPV4_TCP_SHORT)
+    {
+        GenRecord(pcapng, pkt, GEN_SNAP_SHORT, (uint32_t)len, n);
+    }
+    else
+    {
+        GenRecord(pcapng, pkt, (uint32_t)len, (uint32_t)len, n);
+    }
+}
+
+
+/**************************************
+ * GenUsage
+ **************************************/
+static int GenUsage(void)
+{
+    fprintf(stderr, "usage: pcapGen [-n] [-s] [-c count] [-b every] file\n");
+    return 2;
+}
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+/**************************************
+ * main
+ **************************************/
+int main(int argc, char* argv[])
+{
+    const uint16_t one    = 1;
+    GEN_COUNTS     counts;
+    int            pcapng = 0;
+    int            swap   = 0;
+    unsigned long  count  = 10000;
+    unsigned long  every  = 7;
+    unsigned long  n;
+    int            i;
+
+    for (i = 1; (i < argc) && (argv[i][0] == '-'); i++)
+    {
+        if (strcmp(argv[i], "-n") == 0) pcapng = 1;
+        else if (strcmp(argv[i], "-s") == 0) swap = 1;
+        else if ((strcmp(argv[i], "-c") == 0) && (i + 1 < argc)) count = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc)) every = strtoul(argv[++i], NULL, 0);
+        else return GenUsage();
+    }
+    if (i + 1 != argc) return GenUsage();
+
+    GenFile = fopen(argv[i], "wb");
+    if (GenFile == NULL)
+    {
+        perror(argv[i]);
+        return 2;
+    }
+
+    // Host order, or the other one.
+    GenBigEndian = (*(const uint8_t*)&one == 1) ? swap : !swap;
+
+    if (pcapng)
+    {
+        // Section header, interface description, and an empty name
+        // resolution block that the reader must step over.
+        GenPut32(0x0A0D0D0A); GenPut32(28); GenPut32(0x1A2B3C4D);
+        GenPut16(1); GenPut16(0); GenPut32(0xFFFFFFFF); GenPut32(0xFFFFFFFF); GenPut32(28);
+        GenPut32(1); GenPut32(20); GenPut16(1); GenPut16(0); GenPut32(65535); GenPut32(20);
+        GenPut32(4); GenPut32(16); GenPut32(0); GenPut32(16);
+    }
+    else
+    {
+        GenPut32(0xA1B2C3D4); GenPut16(2); GenPut16(4);
+        GenPut32(0); GenPut32(0); GenPut32(65535); GenPut32(1);
+    }
+
+    memset(&counts, 0, sizeof(counts));
+    for (n = 0; n < count; n++)
+    {
+        GenPacket(pcapng, (uint32_t)n, (every != 0) && (n % every == every - 1), &counts);
+    }
+
+    if (fclose(GenFile) != 0)
+    {
+        perror(argv[i]);
+        return 2;
+    }
+
+    printf("verified: ipv4 %lu, tcp %lu, udp %lu\n", counts.ipv4, counts.tcp, counts.udp);
+    printf("bad: ipv4 %lu, tcp %lu, udp %lu\n", counts.ipv4Bad, counts.tcpBad, counts.udpBad);
+    printf("skipped: %lu\n", counts.skipped);
+    return 0;
+}
+
+// End of file.
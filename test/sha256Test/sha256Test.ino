@@ -17,6 +17,21 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added an HMAC, HKDF and PBKDF2 test.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added a sha256_32() and sha256_64() test.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added a sha256_many() test.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added a split sha256_update() test.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added a multi-block sha256_transform() test.
+ *
  * 10/07/2015 - Tom Kerr
  * Added support for automated unit testing over a serial port.
  *
@@ -195,5 +210,108 @@ void loop()
     Serial.print(stop-start);
     Serial.println(F(" ms"));
     
+    // Several blocks in one call must match one block at a time.
+    TEST_NUMBER(1);
+    {
+        uint8_t  blocks[128];
+        uint32_t state1[8];
+        uint32_t state2[8];
+        
+        for (i = 0; i < sizeof(blocks); i++)
+        {
+            blocks[i] = (uint8_t)(i * 7);
+        }
+        sha256_init(&ctx);
+        memcpy(state1, ctx.state, sizeof(state1));
+        memcpy(state2, ctx.state, sizeof(state2));
+        sha256_transform(state1, blocks, 2);
+        sha256_transform(state2, blocks, 1);
+        sha256_transform(state2, blocks + 64, 1);
+        TEST_ASSERT(memcmp(state1, state2, sizeof(state1)) == 0);
+    }
+    
+    // Updates split across block boundaries must match one update.
+    TEST_NUMBER(2);
+    {
+        const size_t len = strlen(text4);
+        uint8_t      hash2[32];
+        
+        sha256_init(&ctx);
+        sha256_update(&ctx, (uint8_t*)text4, len);
+        sha256_final(&ctx, hash);
+        
+        sha256_init(&ctx);
+        sha256_update(&ctx, (uint8_t*)text4, 1);
+        sha256_update(&ctx, (uint8_t*)text4 + 1, 62);
+        sha256_update(&ctx, (uint8_t*)text4 + 63, 0);
+        sha256_update(&ctx, (uint8_t*)text4 + 63, 3);
+        sha256_update(&ctx, (uint8_t*)text4 + 66, len - 66);
+        sha256_final(&ctx, hash2);
+        TEST_ASSERT(memcmp(hash, hash2, sizeof(hash)) == 0);
+    }
+    
+    TEST_NUMBER(3);
+    {
+        const uint8_t* msgs[6] = { (uint8_t*)text1, (uint8_t*)text2, (uint8_t*)text3,
+                                   (uint8_t*)text4, (uint8_t*)text5, (uint8_t*)text4 };
+        size_t         lens[6] = { strlen(text1), strlen(text2), strlen(text3),
+                                   strlen(text4), strlen(text5), 64 };
+        uint8_t        hashes[6][32];
+        
+        sha256_many(msgs, lens, 6, hashes);
+        for (i = 0; i < 6; i++)
+        {
+            sha256_init(&ctx);
+            sha256_update(&ctx, msgs[i], lens[i]);
+            sha256_final(&ctx, hash);
+            TEST_ASSERT(memcmp(hash, hashes[i], sizeof(hash)) == 0);
+        }
+    }
+    
+    TEST_NUMBER(4);
+    {
+        uint8_t hash2[32];
+        
+        sha256_init(&ctx);
+        sha256_update(&ctx, (uint8_t*)text4, 32);
+        sha256_final(&ctx, hash);
+        sha256_32((uint8_t*)text4, hash2);
+        TEST_ASSERT(memcmp(hash, hash2, sizeof(hash)) == 0);
+        
+        sha256_init(&ctx);
+        sha256_update(&ctx, (uint8_t*)text4, 64);
+        sha256_final(&ctx, hash);
+        sha256_64((uint8_t*)text4, hash2);
+        TEST_ASSERT(memcmp(hash, hash2, sizeof(hash)) == 0);
+    }
+    
+    TEST_NUMBER(5);
+    {
+        // RFC 4231 test case 1, RFC 5869 test case 3, and PBKDF2 of
+        // "password" and "salt" with 2 iterations.
+        static const uint8_t hmacMac[32] = {
+            0xb0, 0x34, 0x4c, 0x61, 0xd8, 0xdb, 0x38, 0x53, 0x5c, 0xa8, 0xaf, 0xce, 0xaf, 0x0b, 0xf1, 0x2b,
+            0x88, 0x1d, 0xc2, 0x00, 0xc9, 0x83, 0x3d, 0xa7, 0x26, 0xe9, 0x37, 0x6c, 0x2e, 0x32, 0xcf, 0xf7 };
+        static const uint8_t hkdfOkm[42] = {
+            0x8d, 0xa4, 0xe7, 0x75, 0xa5, 0x63, 0xc1, 0x8f, 0x71, 0x5f, 0x80, 0x2a, 0x06, 0x3c, 0x5a, 0x31,
+            0xb8, 0xa1, 0x1f, 0x5c, 0x5e, 0xe1, 0x87, 0x9e, 0xc3, 0x45, 0x4e, 0x5f, 0x3c, 0x73, 0x8d, 0x2d,
+            0x9d, 0x20, 0x13, 0x95, 0xfa, 0xa4, 0xb6, 0x1a, 0x96, 0xc8 };
+        static const uint8_t pbkdf2Key[32] = {
+            0xae, 0x4d, 0x0c, 0x95, 0xaf, 0x6b, 0x46, 0xd3, 0x2d, 0x0a, 0xdf, 0xf9, 0x28, 0xf0, 0x6d, 0xd0,
+            0x2a, 0x30, 0x3f, 0x8e, 0xf3, 0xc2, 0x51, 0xdf, 0xd6, 0xe2, 0xd8, 0x5a, 0x95, 0x47, 0x4c, 0x43 };
+        uint8_t key[22];
+        uint8_t okm[42];
+        
+        memset(key, 0x0b, sizeof(key));
+        hmac_sha256(key, 20, (uint8_t*)"Hi There", 8, hash);
+        TEST_ASSERT(memcmp(hash, hmacMac, sizeof(hash)) == 0);
+        
+        TEST_ASSERT(hkdf_sha256(NULL, 0, key, 22, NULL, 0, okm, sizeof(okm)) == 0);
+        TEST_ASSERT(memcmp(okm, hkdfOkm, sizeof(okm)) == 0);
+        
+        pbkdf2_sha256((uint8_t*)"password", 8, (uint8_t*)"salt", 4, 2, hash, sizeof(hash));
+        TEST_ASSERT(memcmp(hash, pbkdf2Key, sizeof(hash)) == 0);
+    }
+    
     TEST_DONE();
 }
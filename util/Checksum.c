@@ -7,6 +7,24 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * checksum() sums unsigned bytes, handles a zero length, and has SSE2/AVX2
+ * kernels.  Added fletcher16(), fletcher32() and adler32().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added ipv4_sum_partial(), ipv4_sum_copy() and ipv4_sum_combine().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added l4_checksum_v4() and l4_checksum_v6().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added ipv4_checksum_update16(), ipv4_checksum_update32() and
+ * ipv4_checksum_update() (RFC 1624).
+ *
+ * 10/18/2026 - Tom Kerr
+ * Rewrote ipv4_checksum() with a 64-bit sum, odd and zero length handling,
+ * and SSE2/AVX2 kernels.
+ *
  * 09/18/2015 - Tom Kerr
  * Added ipv4_checksum().
  *
@@ -23,24 +41,72 @@
 /******************************************************************************
  * System include files.
  ******************************************************************************/
+#include <string.h>
 
 
 /******************************************************************************
  * Local include files.
  ******************************************************************************/
-#include "checksum.h"
-#include "UnionTypeDefs.h"
+#include "Checksum.h"
+
+#if defined(USE_CHECKSUM_SIMD)
+#include <immintrin.h>
+#endif
 
 
 /******************************************************************************
  * Forward references.
  ******************************************************************************/
+static uint32_t byte_sum_scalar(const uint8_t* ptr, size_t len, uint32_t start);
+static void fletcher_bytes(const uint8_t* ptr, size_t len, uint32_t mod, uint32_t* pA, uint32_t* pB);
+static void fletcher_words(const uint8_t* ptr, size_t len, uint32_t* pA, uint32_t* pB);
+static uint64_t ipv4_sum(const void* pData, size_t len);
+static uint64_t ipv4_sum_scalar(const uint8_t* ptr, size_t len, uint64_t start);
+static uint64_t ipv4_sum_copy_scalar(uint8_t* dst, const uint8_t* src, size_t len, uint64_t start);
+static uint64_t ipv4_add(uint64_t a, uint64_t b);
+static uint16_t ipv4_fold(uint64_t sum);
+static uint64_t l4_sum_payload(const struct iovec* iov, int iovcnt, size_t* len);
+static uint64_t l4_sum_length(uint8_t proto, uint32_t len);
+
+#if defined(USE_CHECKSUM_SIMD)
+static uint32_t byte_sum_sse2(const uint8_t* ptr, size_t len);
+static uint32_t byte_sum_avx2(const uint8_t* ptr, size_t len);
+static void fletcher_bytes_avx2(const uint8_t* ptr, size_t len, uint32_t* pA, uint32_t* pB);
+static void fletcher_words_avx2(const uint8_t* ptr, size_t len, uint32_t* pA, uint32_t* pB);
+static uint32_t hsum_avx2(__m256i v);
+static uint64_t ipv4_sum_sse2(const uint8_t* ptr, size_t len);
+static uint64_t ipv4_sum_avx2(const uint8_t* ptr, size_t len);
+static uint64_t ipv4_sum_copy_sse2(uint8_t* dst, const uint8_t* src, size_t len);
+static uint64_t ipv4_sum_copy_avx2(uint8_t* dst, const uint8_t* src, size_t len);
+#endif
 
 
 /******************************************************************************
  * Local definitions.
  ******************************************************************************/
 
+/**
+ * @brief
+ * Below this many bytes the scalar sum beats the vector kernels' setup and
+ * final reduction.
+ */
+#define IPV4_SIMD_MIN 64
+
+/**
+ * @brief
+ * Most bytes the Fletcher-16 and Adler-32 sums can take in 32 bits before
+ * they must be reduced (zlib's NMAX): 255n(n+1)/2 + (n+1)(m-1) < 2^32 for
+ * the larger modulus m = 65521.
+ */
+#define FLETCHER_NMAX 5552
+
+/**
+ * @brief
+ * Most words the Fletcher-32 sums can take in 32 bits before they must be
+ * reduced, by the same bound with 65535 for 255 and m = 65535.
+ */
+#define FLETCHER32_NMAX 359
+
 
 /******************************************************************************
  * Local data.
@@ -56,10 +122,62 @@
  **************************************/
 char checksum(const void* pData, size_t len)
 {
-    char* ptr = (char*) pData;
-    char  sum = 0;
-    do {sum += *ptr++;} while (--len);
-    return ~sum + 1;
+    const uint8_t* ptr = (const uint8_t*)pData;
+    uint32_t       sum;
+    
+#if defined(USE_CHECKSUM_SIMD)
+    if (len >= IPV4_SIMD_MIN)
+    {
+        if (__builtin_cpu_supports("avx2")) sum = byte_sum_avx2(ptr, len);
+        else if (__builtin_cpu_supports("sse2")) sum = byte_sum_sse2(ptr, len);
+        else sum = byte_sum_scalar(ptr, len, 0);
+    }
+    else
+#endif
+    {
+        sum = byte_sum_scalar(ptr, len, 0);
+    }
+    
+    return (char)(uint8_t)(0u - sum);
+}
+
+
+/**************************************
+ * fletcher16
+ **************************************/
+uint16_t fletcher16(const void* pData, size_t len)
+{
+    uint32_t a = 0;
+    uint32_t b = 0;
+    
+    fletcher_bytes((const uint8_t*)pData, len, 255, &a, &b);
+    return (uint16_t)((b << 8) | a);
+}
+
+
+/**************************************
+ * fletcher32
+ **************************************/
+uint32_t fletcher32(const void* pData, size_t len)
+{
+    uint32_t a = 0;
+    uint32_t b = 0;
+    
+    fletcher_words((const uint8_t*)pData, len, &a, &b);
+    return (b << 16) | a;
+}
+
+
+/**************************************
+ * adler32
+ **************************************/
+uint32_t adler32(const void* pData, size_t len)
+{
+    uint32_t a = 1;
+    uint32_t b = 0;
+    
+    fletcher_bytes((const uint8_t*)pData, len, 65521, &a, &b);
+    return (b << 16) | a;
 }
 
 
@@ -68,23 +186,680 @@ char checksum(const void* pData, size_t len)
  **************************************/
 uint16_t ipv4_checksum(const void* pData, size_t len)
 {
-    uint32u_t sum;
+    return (uint16_t)~ipv4_fold(ipv4_sum(pData, len));
+}
+
+
+/**************************************
+ * ipv4_checksum_update16
+ **************************************/
+uint16_t ipv4_checksum_update16(uint16_t sum, uint16_t oldField, uint16_t newField)
+{
+    // HC' = ~(~HC + ~m + m')
+    uint32_t acc = (uint32_t)(uint16_t)~sum + (uint16_t)~oldField + newField;
+    return (uint16_t)~ipv4_fold(acc);
+}
+
+
+/**************************************
+ * ipv4_checksum_update32
+ **************************************/
+uint16_t ipv4_checksum_update32(uint16_t sum, uint32_t oldField, uint32_t newField)
+{
+    // The same, one 16-bit half of the field at a time.
+    uint32_t acc = (uint32_t)(uint16_t)~sum;
+    acc += (uint16_t)~(oldField >> 16) + (uint16_t)~oldField;
+    acc += (newField >> 16) + (newField & 0xFFFFu);
+    return (uint16_t)~ipv4_fold(acc);
+}
+
+
+/**************************************
+ * ipv4_checksum_update
+ **************************************/
+uint16_t ipv4_checksum_update(uint16_t sum, const void* oldField, const void* newField, size_t len)
+{
+    // ~m is -m in one's complement arithmetic, so the sum of the old words
+    // can be folded first and then complemented.  Zero padding of an odd
+    // length adds nothing to either sum.
+    uint16_t oldSum = ipv4_fold(ipv4_sum(oldField, len));
+    uint16_t newSum = ipv4_fold(ipv4_sum(newField, len));
+    uint32_t acc    = (uint32_t)(uint16_t)~sum + (uint16_t)~oldSum + newSum;
+    return (uint16_t)~ipv4_fold(acc);
+}
+
+
+/**************************************
+ * ipv4_sum_partial
+ **************************************/
+uint16_t ipv4_sum_partial(const void* pData, size_t len)
+{
+    return ipv4_fold(ipv4_sum(pData, len));
+}
+
+
+/**************************************
+ * ipv4_sum_copy
+ **************************************/
+uint16_t ipv4_sum_copy(void* dst, const void* src, size_t len)
+{
+    uint8_t*       to   = (uint8_t*)dst;
+    const uint8_t* from = (const uint8_t*)src;
     
-    uint16_t* ptr = (uint16_t*) pData;
-    size_t i = len / sizeof(uint16_t);
-    sum.v = 0;
-    do {sum.v += *ptr++;} while (--i);
+#if defined(USE_CHECKSUM_SIMD)
+    if (len >= IPV4_SIMD_MIN)
+    {
+        if (__builtin_cpu_supports("avx2")) return ipv4_fold(ipv4_sum_copy_avx2(to, from, len));
+        if (__builtin_cpu_supports("sse2")) return ipv4_fold(ipv4_sum_copy_sse2(to, from, len));
+    }
+#endif
+
+    return ipv4_fold(ipv4_sum_copy_scalar(to, from, len, 0));
+}
+
+
+/**************************************
+ * ipv4_sum_combine
+ **************************************/
+uint16_t ipv4_sum_combine(uint16_t sum, uint16_t part, size_t offset)
+{
+    if (offset & 1)
+    {
+        part = (uint16_t)((part << 8) | (part >> 8));
+    }
+    return ipv4_fold(ipv4_add(sum, part));
+}
+
+
+/**************************************
+ * l4_checksum_v4
+ **************************************/
+uint16_t l4_checksum_v4(const uint8_t* src, const uint8_t* dst, uint8_t proto,
+                        const struct iovec* iov, int iovcnt)
+{
+    size_t   len;
+    uint64_t sum = l4_sum_payload(iov, iovcnt, &len);
     
-    // If a carry exists, add it back to the checksum.
-    while (sum.w[1] != 0) {sum.v = sum.w[0] + sum.w[1];}
+    sum = ipv4_add(sum, ipv4_sum_scalar(src, 4, 0));
+    sum = ipv4_add(sum, ipv4_sum_scalar(dst, 4, 0));
+    sum = ipv4_add(sum, l4_sum_length(proto, (uint16_t)len));
+    return (uint16_t)~ipv4_fold(sum);
+}
+
+
+/**************************************
+ * l4_checksum_v6
+ **************************************/
+uint16_t l4_checksum_v6(const uint8_t* src, const uint8_t* dst, uint8_t proto,
+                        const struct iovec* iov, int iovcnt)
+{
+    size_t   len;
+    uint64_t sum = l4_sum_payload(iov, iovcnt, &len);
     
-    return ~sum.w[0];
+    sum = ipv4_add(sum, ipv4_sum_scalar(src, 16, 0));
+    sum = ipv4_add(sum, ipv4_sum_scalar(dst, 16, 0));
+    sum = ipv4_add(sum, l4_sum_length(proto, (uint32_t)len));
+    return (uint16_t)~ipv4_fold(sum);
 }
 
 
 /*****************************************************************************
  * Private functions.
  ******************************************************************************/
- 
+
+/*
+ * Sums.
+ *
+ * The one's complement sum of 16-bit words is their ordinary sum modulo
+ * 0xFFFF, and 2^16 = 1 modulo 0xFFFF.  So a 32-bit word counts the same as
+ * its two 16-bit halves, and a carry out of bit 63 counts as 1.  The
+ * kernels below add 32-bit words into 64-bit accumulators, which take
+ * over 2^32 words each to overflow, and fold to 16 bits once at the end.
+ */
+
+/**************************************
+ * byte_sum_scalar
+ **************************************/
+static uint32_t byte_sum_scalar(const uint8_t* ptr, size_t len, uint32_t start)
+{
+    uint32_t sum = start;
+    
+    for (; len > 0; len--)
+    {
+        sum += *ptr++;
+    }
+    return sum;
+}
+
+
+/*
+ * Fletcher and Adler sums.
+ *
+ * Over bytes d[0] .. d[n-1], the first sum gains S1 = d[0] + ... + d[n-1]
+ * and the second gains n*A + (n)d[0] + (n-1)d[1] + ... + (1)d[n-1], where
+ * A is the first sum before the block.  The kernels below compute S1 and
+ * the weighted sum a vector at a time, and reduce modulo m only once per
+ * FLETCHER_NMAX bytes.
+ */
+
+/**************************************
+ * fletcher_bytes
+ **************************************/
+static void fletcher_bytes(const uint8_t* ptr, size_t len, uint32_t mod, uint32_t* pA, uint32_t* pB)
+{
+    uint32_t a = *pA;
+    uint32_t b = *pB;
+    size_t   n;
+    
+    while (len > 0)
+    {
+        n = (len < FLETCHER_NMAX) ? len : FLETCHER_NMAX;
+        len -= n;
+        
+#if defined(USE_CHECKSUM_SIMD)
+        if ((n >= 32) && __builtin_cpu_supports("avx2"))
+        {
+            size_t vec = n & ~(size_t)31;
+            
+            fletcher_bytes_avx2(ptr, vec, &a, &b);
+            ptr += vec;
+            n   -= vec;
+        }
+#endif
+        for (; n > 0; n--)
+        {
+            a += *ptr++;
+            b += a;
+        }
+        a %= mod;
+        b %= mod;
+    }
+    
+    *pA = a;
+    *pB = b;
+}
+
+
+/**************************************
+ * fletcher_words
+ **************************************/
+static void fletcher_words(const uint8_t* ptr, size_t len, uint32_t* pA, uint32_t* pB)
+{
+    uint32_t a = *pA;
+    uint32_t b = *pB;
+    size_t   n;
+    uint16_t word;
+    uint8_t  last[2];
+    
+    while (len > 1)
+    {
+        n = len / 2;
+        if (n > FLETCHER32_NMAX) n = FLETCHER32_NMAX;
+        len -= 2 * n;
+        
+#if defined(USE_CHECKSUM_SIMD)
+        if ((n >= 16) && __builtin_cpu_supports("avx2"))
+        {
+            size_t vec = n & ~(size_t)15;
+            
+            fletcher_words_avx2(ptr, vec, &a, &b);
+            ptr += 2 * vec;
+            n   -= vec;
+        }
+#endif
+        for (; n > 0; n--)
+        {
+            memcpy(&word, ptr, 2);
+            a += word;
+            b += a;
+            ptr += 2;
+        }
+        a %= 65535;
+        b %= 65535;
+    }
+    
+    if (len == 1)
+    {
+        // Pad in memory order, as for ipv4_checksum().
+        last[0] = *ptr;
+        last[1] = 0;
+        memcpy(&word, last, 2);
+        a = (a + word) % 65535;
+        b = (b + a) % 65535;
+    }
+    
+    *pA = a;
+    *pB = b;
+}
+
+
+/**************************************
+ * ipv4_sum
+ **************************************/
+static uint64_t ipv4_sum(const void* pData, size_t len)
+{
+    const uint8_t* ptr = (const uint8_t*)pData;
+    
+#if defined(USE_CHECKSUM_SIMD)
+    if (len >= IPV4_SIMD_MIN)
+    {
+        if (__builtin_cpu_supports("avx2")) return ipv4_sum_avx2(ptr, len);
+        if (__builtin_cpu_supports("sse2")) return ipv4_sum_sse2(ptr, len);
+    }
+#endif
+
+    return ipv4_sum_scalar(ptr, len, 0);
+}
+
+
+/**************************************
+ * ipv4_sum_scalar
+ **************************************/
+static uint64_t ipv4_sum_scalar(const uint8_t* ptr, size_t len, uint64_t start)
+{
+    uint64_t sum  = 0;
+    uint64_t sum2 = 0;
+    uint32_t word1;
+    uint32_t word2;
+    uint16_t half;
+    uint8_t  last[2];
+    
+    // Two accumulators, eight bytes per pass.
+    for (; len >= 8; len -= 8)
+    {
+        memcpy(&word1, ptr, 4);
+        memcpy(&word2, ptr + 4, 4);
+        sum  += word1;
+        sum2 += word2;
+        ptr  += 8;
+    }
+    sum = ipv4_add(ipv4_add(sum, sum2), start);
+    
+    if (len >= 4)
+    {
+        memcpy(&word1, ptr, 4);
+        sum = ipv4_add(sum, word1);
+        ptr += 4;
+        len -= 4;
+    }
+    if (len >= 2)
+    {
+        memcpy(&half, ptr, 2);
+        sum = ipv4_add(sum, half);
+        ptr += 2;
+        len -= 2;
+    }
+    if (len == 1)
+    {
+        // Pad in memory order, so the byte lands in the right half on
+        // either endianness.
+        last[0] = *ptr;
+        last[1] = 0;
+        memcpy(&half, last, 2);
+        sum = ipv4_add(sum, half);
+    }
+    
+    return sum;
+}
+
+
+/**************************************
+ * ipv4_sum_copy_scalar
+ **************************************/
+static uint64_t ipv4_sum_copy_scalar(uint8_t* dst, const uint8_t* src, size_t len, uint64_t start)
+{
+    uint64_t sum  = 0;
+    uint64_t sum2 = 0;
+    uint32_t word1;
+    uint32_t word2;
+    
+    for (; len >= 8; len -= 8)
+    {
+        memcpy(&word1, src, 4);
+        memcpy(&word2, src + 4, 4);
+        memcpy(dst, &word1, 4);
+        memcpy(dst + 4, &word2, 4);
+        sum  += word1;
+        sum2 += word2;
+        src  += 8;
+        dst  += 8;
+    }
+    
+    // Copy the tail and sum it from src, not from the bytes just stored
+    // to dst, so the sum does not wait on those stores.
+    memcpy(dst, src, len);
+    return ipv4_sum_scalar(src, len, ipv4_add(ipv4_add(sum, sum2), start));
+}
+
+
+/**************************************
+ * ipv4_add
+ **************************************/
+static uint64_t ipv4_add(uint64_t a, uint64_t b)
+{
+    // Add with end-around carry.
+    a += b;
+    return a + (a < b);
+}
+
+
+/**************************************
+ * ipv4_fold
+ **************************************/
+static uint16_t ipv4_fold(uint64_t sum)
+{
+    sum = (sum & 0xFFFFFFFFu) + (sum >> 32);
+    sum = (sum & 0xFFFFu) + (sum >> 16);
+    sum = (sum & 0xFFFFu) + (sum >> 16);
+    sum = (sum & 0xFFFFu) + (sum >> 16);
+    return (uint16_t)sum;
+}
+
+
+/**************************************
+ * l4_sum_payload
+ **************************************/
+static uint64_t l4_sum_payload(const struct iovec* iov, int iovcnt, size_t* len)
+{
+    uint16_t sum    = 0;
+    size_t   offset = 0;
+    int      i;
+    
+    for (i = 0; i < iovcnt; i++)
+    {
+        sum = ipv4_sum_combine(sum, ipv4_sum_partial(iov[i].iov_base, iov[i].iov_len), offset);
+        offset += iov[i].iov_len;
+    }
+    
+    *len = offset;
+    return sum;
+}
+
+
+/**************************************
+ * l4_sum_length
+ **************************************/
+static uint64_t l4_sum_length(uint8_t proto, uint32_t len)
+{
+    // The protocol and length words of the pseudo-header, in network byte
+    // order, read back in host order like the rest of the data.  Zero high
+    // words of the IPv4 length add nothing, so one layout serves both.
+    uint8_t words[6];
+    
+    words[0] = (uint8_t)(len >> 24);
+    words[1] = (uint8_t)(len >> 16);
+    words[2] = (uint8_t)(len >> 8);
+    words[3] = (uint8_t)len;
+    words[4] = 0;
+    words[5] = proto;
+    return ipv4_sum_scalar(words, sizeof(words), 0);
+}
+
+
+#if defined(USE_CHECKSUM_SIMD)
+
+/**************************************
+ * byte_sum_sse2
+ **************************************/
+__attribute__((target("sse2")))
+static uint32_t byte_sum_sse2(const uint8_t* ptr, size_t len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    __m128i acc2 = _mm_setzero_si128();
+    uint64_t lane[2];
+    
+    // psadbw against zero sums each group of eight bytes into a 64-bit lane.
+    for (; len >= 32; len -= 32)
+    {
+        acc1 = _mm_add_epi64(acc1, _mm_sad_epu8(_mm_loadu_si128((const __m128i*)ptr), zero));
+        acc2 = _mm_add_epi64(acc2, _mm_sad_epu8(_mm_loadu_si128((const __m128i*)(ptr + 16)), zero));
+        ptr += 32;
+    }
+    
+    _mm_storeu_si128((__m128i*)lane, _mm_add_epi64(acc1, acc2));
+    return byte_sum_scalar(ptr, len, (uint32_t)(lane[0] + lane[1]));
+}
+
+
+/**************************************
+ * byte_sum_avx2
+ **************************************/
+__attribute__((target("avx2")))
+static uint32_t byte_sum_avx2(const uint8_t* ptr, size_t len)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256();
+    uint64_t lane[4];
+    
+    for (; len >= 64; len -= 64)
+    {
+        acc1 = _mm256_add_epi64(acc1, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i*)ptr), zero));
+        acc2 = _mm256_add_epi64(acc2, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i*)(ptr + 32)), zero));
+        ptr += 64;
+    }
+    
+    _mm256_storeu_si256((__m256i*)lane, _mm256_add_epi64(acc1, acc2));
+    return byte_sum_scalar(ptr, len, (uint32_t)(lane[0] + lane[1] + lane[2] + lane[3]));
+}
+
+
+/**************************************
+ * fletcher_bytes_avx2
+ **************************************/
+__attribute__((target("avx2")))
+static void fletcher_bytes_avx2(const uint8_t* ptr, size_t len, uint32_t* pA, uint32_t* pB)
+{
+    const __m256i zero    = _mm256_setzero_si256();
+    const __m256i ones    = _mm256_set1_epi16(1);
+    const __m256i weights = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                             24, 23, 22, 21, 20, 19, 18, 17,
+                                             16, 15, 14, 13, 12, 11, 10,  9,
+                                              8,  7,  6,  5,  4,  3,  2,  1);
+    __m256i  sum1  = _mm256_setzero_si256();  // Bytes so far
+    __m256i  prev  = _mm256_setzero_si256();  // sum1 before each vector
+    __m256i  sum2  = _mm256_setzero_si256();  // Bytes weighted within each vector
+    __m256i  v;
+    uint32_t count = (uint32_t)len;
+    
+    // len is a multiple of 32, at most FLETCHER_NMAX.
+    for (; len > 0; len -= 32)
+    {
+        v = _mm256_loadu_si256((const __m256i*)ptr);
+        prev = _mm256_add_epi32(prev, sum1);
+        sum1 = _mm256_add_epi32(sum1, _mm256_sad_epu8(v, zero));
+        sum2 = _mm256_add_epi32(sum2, _mm256_madd_epi16(_mm256_maddubs_epi16(v, weights), ones));
+        ptr += 32;
+    }
+    
+    // Every byte of a vector has 32 more bytes' weight than the same byte
+    // of the next one.
+    *pB += count * *pA + 32 * hsum_avx2(prev) + hsum_avx2(sum2);
+    *pA += hsum_avx2(sum1);
+}
+
+
+/**************************************
+ * fletcher_words_avx2
+ **************************************/
+__attribute__((target("avx2")))
+static void fletcher_words_avx2(const uint8_t* ptr, size_t len, uint32_t* pA, uint32_t* pB)
+{
+    const __m256i weightsLo = _mm256_setr_epi32(16, 15, 14, 13, 12, 11, 10, 9);
+    const __m256i weightsHi = _mm256_setr_epi32( 8,  7,  6,  5,  4,  3,  2, 1);
+    __m256i  sum1  = _mm256_setzero_si256();
+    __m256i  prev  = _mm256_setzero_si256();
+    __m256i  sum2  = _mm256_setzero_si256();
+    __m256i  v;
+    __m256i  lo;
+    __m256i  hi;
+    uint32_t count = (uint32_t)len;
+    
+    // len is in words, a multiple of 16, at most FLETCHER32_NMAX.
+    for (; len > 0; len -= 16)
+    {
+        v  = _mm256_loadu_si256((const __m256i*)ptr);
+        lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v));
+        hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1));
+        prev = _mm256_add_epi32(prev, sum1);
+        sum1 = _mm256_add_epi32(sum1, _mm256_add_epi32(lo, hi));
+        sum2 = _mm256_add_epi32(sum2, _mm256_add_epi32(_mm256_mullo_epi32(lo, weightsLo),
+                                                       _mm256_mullo_epi32(hi, weightsHi)));
+        ptr += 32;
+    }
+    
+    *pB += count * *pA + 16 * hsum_avx2(prev) + hsum_avx2(sum2);
+    *pA += hsum_avx2(sum1);
+}
+
+
+/**************************************
+ * hsum_avx2
+ **************************************/
+__attribute__((target("avx2")))
+static uint32_t hsum_avx2(__m256i v)
+{
+    uint32_t lane[8];
+    
+    _mm256_storeu_si256((__m256i*)lane, v);
+    return lane[0] + lane[1] + lane[2] + lane[3] + lane[4] + lane[5] + lane[6] + lane[7];
+}
+
+
+/**************************************
+ * ipv4_sum_sse2
+ **************************************/
+__attribute__((target("sse2")))
+static uint64_t ipv4_sum_sse2(const uint8_t* ptr, size_t len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    __m128i acc2 = _mm_setzero_si128();
+    __m128i v1;
+    __m128i v2;
+    uint64_t lane[2];
+    
+    // Zero-extend each 32-bit word to 64 bits and add.
+    for (; len >= 32; len -= 32)
+    {
+        v1 = _mm_loadu_si128((const __m128i*)ptr);
+        v2 = _mm_loadu_si128((const __m128i*)(ptr + 16));
+        acc1 = _mm_add_epi64(acc1, _mm_unpacklo_epi32(v1, zero));
+        acc2 = _mm_add_epi64(acc2, _mm_unpackhi_epi32(v1, zero));
+        acc1 = _mm_add_epi64(acc1, _mm_unpacklo_epi32(v2, zero));
+        acc2 = _mm_add_epi64(acc2, _mm_unpackhi_epi32(v2, zero));
+        ptr += 32;
+    }
+    
+    _mm_storeu_si128((__m128i*)lane, _mm_add_epi64(acc1, acc2));
+    return ipv4_sum_scalar(ptr, len, ipv4_add(lane[0], lane[1]));
+}
+
+
+/**************************************
+ * ipv4_sum_avx2
+ **************************************/
+__attribute__((target("avx2")))
+static uint64_t ipv4_sum_avx2(const uint8_t* ptr, size_t len)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256();
+    __m256i acc3 = _mm256_setzero_si256();
+    __m256i acc4 = _mm256_setzero_si256();
+    __m256i v1;
+    __m256i v2;
+    uint64_t lane[4];
+    uint64_t sum;
+    
+    for (; len >= 64; len -= 64)
+    {
+        v1 = _mm256_loadu_si256((const __m256i*)ptr);
+        v2 = _mm256_loadu_si256((const __m256i*)(ptr + 32));
+        acc1 = _mm256_add_epi64(acc1, _mm256_unpacklo_epi32(v1, zero));
+        acc2 = _mm256_add_epi64(acc2, _mm256_unpackhi_epi32(v1, zero));
+        acc3 = _mm256_add_epi64(acc3, _mm256_unpacklo_epi32(v2, zero));
+        acc4 = _mm256_add_epi64(acc4, _mm256_unpackhi_epi32(v2, zero));
+        ptr += 64;
+    }
+    
+    acc1 = _mm256_add_epi64(_mm256_add_epi64(acc1, acc2), _mm256_add_epi64(acc3, acc4));
+    _mm256_storeu_si256((__m256i*)lane, acc1);
+    sum = ipv4_add(ipv4_add(lane[0], lane[1]), ipv4_add(lane[2], lane[3]));
+    return ipv4_sum_scalar(ptr, len, sum);
+}
+
+
+/**************************************
+ * ipv4_sum_copy_sse2
+ **************************************/
+__attribute__((target("sse2")))
+static uint64_t ipv4_sum_copy_sse2(uint8_t* dst, const uint8_t* src, size_t len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    __m128i acc2 = _mm_setzero_si128();
+    __m128i v1;
+    __m128i v2;
+    uint64_t lane[2];
+    
+    for (; len >= 32; len -= 32)
+    {
+        v1 = _mm_loadu_si128((const __m128i*)src);
+        v2 = _mm_loadu_si128((const __m128i*)(src + 16));
+        _mm_storeu_si128((__m128i*)dst, v1);
+        _mm_storeu_si128((__m128i*)(dst + 16), v2);
+        acc1 = _mm_add_epi64(acc1, _mm_unpacklo_epi32(v1, zero));
+        acc2 = _mm_add_epi64(acc2, _mm_unpackhi_epi32(v1, zero));
+        acc1 = _mm_add_epi64(acc1, _mm_unpacklo_epi32(v2, zero));
+        acc2 = _mm_add_epi64(acc2, _mm_unpackhi_epi32(v2, zero));
+        src += 32;
+        dst += 32;
+    }
+    
+    _mm_storeu_si128((__m128i*)lane, _mm_add_epi64(acc1, acc2));
+    return ipv4_sum_copy_scalar(dst, src, len, ipv4_add(lane[0], lane[1]));
+}
+
+
+/**************************************
+ * ipv4_sum_copy_avx2
+ **************************************/
+__attribute__((target("avx2")))
+static uint64_t ipv4_sum_copy_avx2(uint8_t* dst, const uint8_t* src, size_t len)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256();
+    __m256i acc3 = _mm256_setzero_si256();
+    __m256i acc4 = _mm256_setzero_si256();
+    __m256i v1;
+    __m256i v2;
+    uint64_t lane[4];
+    uint64_t sum;
+    
+    for (; len >= 64; len -= 64)
+    {
+        v1 = _mm256_loadu_si256((const __m256i*)src);
+        v2 = _mm256_loadu_si256((const __m256i*)(src + 32));
+        _mm256_storeu_si256((__m256i*)dst, v1);
+        _mm256_storeu_si256((__m256i*)(dst + 32), v2);
+        acc1 = _mm256_add_epi64(acc1, _mm256_unpacklo_epi32(v1, zero));
+        acc2 = _mm256_add_epi64(acc2, _mm256_unpackhi_epi32(v1, zero));
+        acc3 = _mm256_add_epi64(acc3, _mm256_unpacklo_epi32(v2, zero));
+        acc4 = _mm256_add_epi64(acc4, _mm256_unpackhi_epi32(v2, zero));
+        src += 64;
+        dst += 64;
+    }
+    
+    acc1 = _mm256_add_epi64(_mm256_add_epi64(acc1, acc2), _mm256_add_epi64(acc3, acc4));
+    _mm256_storeu_si256((__m256i*)lane, acc1);
+    sum = ipv4_add(ipv4_add(lane[0], lane[1]), ipv4_add(lane[2], lane[3]));
+    return ipv4_sum_copy_scalar(dst, src, len, sum);
+}
+
+#endif // USE_CHECKSUM_SIMD
+
 
 // End of file.
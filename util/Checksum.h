@@ -7,6 +7,24 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * checksum() sums unsigned bytes, handles a zero length, and has SSE2/AVX2
+ * kernels.  Added fletcher16(), fletcher32() and adler32().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added ipv4_sum_partial(), ipv4_sum_copy() and ipv4_sum_combine().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added l4_checksum_v4() and l4_checksum_v6().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added ipv4_checksum_update16(), ipv4_checksum_update32() and
+ * ipv4_checksum_update() (RFC 1624).
+ *
+ * 10/18/2026 - Tom Kerr
+ * ipv4_checksum() handles odd and zero lengths, and has SSE2/AVX2 kernels
+ * (see USE_CHECKSUM_SIMD).
+ *
  * 09/18/2015 - Tom Kerr
  * Added ipv4_checksum().
  *
@@ -33,11 +51,24 @@
 /******************************************************************************
  * Local include files.
  ******************************************************************************/
+#include "Iovec.h"
 
 
 /******************************************************************************
  * Public definitions.
  ******************************************************************************/
+
+/**
+ * @brief
+ * Defined when the checksums have SSE2 and AVX2 kernels.  The AVX2 kernels
+ * are selected at run time on CPUs that have them.
+ *
+ * Defined automatically for x86 GCC/Clang builds unless NO_CHECKSUM_SIMD
+ * is defined.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(NO_CHECKSUM_SIMD)
+#define USE_CHECKSUM_SIMD
+#endif
  
  
 /******************************************************************************
@@ -56,6 +87,11 @@ extern "C" {
  * calculated, data integrity verified by performing the checksum on the 
  * data + checksum and verifying that it sums to zero.
  *
+ * The bytes are summed as unsigned values, so the result does not depend
+ * on the signedness of char.  A zero length returns 0.  Long blocks are
+ * summed 32 or 64 bytes at a time with SSE2 or AVX2 (psadbw) when
+ * USE_CHECKSUM_SIMD is defined.
+ *
  * @param pData Pointer to the block of data.
  *
  * @param len The size of the data block in bytes.
@@ -64,6 +100,65 @@ extern "C" {
  */
 char checksum(const void* pData, size_t len);
 
+/**
+ * @brief
+ * Computes the Fletcher-16 checksum of a block of data.
+ *
+ * Two running sums of the bytes modulo 255; the second sums the first, so
+ * unlike checksum() the result depends on the order of the bytes.  The
+ * check value of "abcde" is 0xC8F0.
+ *
+ * Blocks of 32 bytes or more are summed with AVX2 on CPUs that have it
+ * when USE_CHECKSUM_SIMD is defined.
+ *
+ * References:
+ *  + J. G. Fletcher. "An Arithmetic Checksum for Serial Transmissions".
+ * IEEE Transactions on Communications. January 1982.
+ *
+ * @param pData Pointer to the block of data.
+ *
+ * @param len The size of the data block in bytes.
+ *
+ * @return The checksum, with the second sum in the high byte.
+ */
+uint16_t fletcher16(const void* pData, size_t len);
+
+/**
+ * @brief
+ * Computes the Fletcher-32 checksum of a block of data.
+ *
+ * As fletcher16(), over 16-bit words modulo 65535.  Words are read in host
+ * byte order from any alignment, and an odd trailing byte is padded with a
+ * zero byte.  The check value of "abcde" on a little-endian target is
+ * 0xF04FC729.
+ *
+ * @param pData Pointer to the block of data.
+ *
+ * @param len The size of the data block in bytes.
+ *
+ * @return The checksum, with the second sum in the high half.
+ */
+uint32_t fletcher32(const void* pData, size_t len);
+
+/**
+ * @brief
+ * Computes the Adler-32 checksum of a block of data.
+ *
+ * As fletcher16(), with 16-bit sums modulo 65521 and the first sum starting
+ * at 1, as used by zlib.  The check value of "Wikipedia" is 0x11E60398.
+ *
+ * References:
+ *  + "ZLIB Compressed Data Format Specification version 3.3". IETF.
+ * May 1996. RFC 1950.
+ *
+ * @param pData Pointer to the block of data.
+ *
+ * @param len The size of the data block in bytes.
+ *
+ * @return The checksum, with the second sum in the high half.
+ */
+uint32_t adler32(const void* pData, size_t len);
+
 /**
  * @brief
  * Computes the  IPv4 header checksum on a block of data.
@@ -72,6 +167,15 @@ char checksum(const void* pData, size_t len);
  * header's 16-bit words. The result of summing the entire IP header, 
  * including checksum, should be zero if there is no corruption.
  *
+ * Words are read in host byte order from any alignment, and the result is
+ * in the same order, so it can be stored into the header as it is.  An odd
+ * trailing byte is padded with a zero byte (RFC 1071).  A zero length
+ * returns 0xFFFF.
+ *
+ * Suitable for whole packets as well as headers: the sum is kept in 64 bits
+ * and folded to 16 only once, and long blocks are summed 32 or 64 bytes at
+ * a time with SSE2 or AVX2 when USE_CHECKSUM_SIMD is defined.
+ *
  * References:
  *  + https://en.wikipedia.org/wiki/IPv4_header_checksum.
  *
@@ -86,6 +190,189 @@ char checksum(const void* pData, size_t len);
  */
 uint16_t ipv4_checksum(const void* pData, size_t len);
 
+/**
+ * @brief
+ * Updates an IPv4 header checksum after a 16-bit field changes, without
+ * summing the header again.
+ *
+ * Implements HC' = ~(~HC + ~m + m') from RFC 1624, which, unlike the
+ * RFC 1141 form, gives the same result as recomputing the checksum with
+ * ipv4_checksum() for any header that is not all zeros.
+ *
+ * The field must start at an even offset in the header.  Its values are in
+ * host byte order as read from the header, the same order ipv4_checksum()
+ * works in; for example, the TTL/protocol word read with a 16-bit load.
+ *
+ * References:
+ *  + "Computation of the Internet Checksum via Incremental Update".
+ * IETF. May 1994. RFC 1624.
+ *
+ * @param sum The checksum before the change.
+ *
+ * @param oldField The old value of the field.
+ *
+ * @param newField The new value of the field.
+ *
+ * @return The checksum after the change.
+ */
+uint16_t ipv4_checksum_update16(uint16_t sum, uint16_t oldField, uint16_t newField);
+
+/**
+ * @brief
+ * Updates an IPv4 header checksum after a 32-bit field, such as an
+ * address, changes.
+ *
+ * See ipv4_checksum_update16().  The field must start at an even offset in
+ * the header, and its values are in host byte order as read from the header
+ * with a 32-bit load.
+ *
+ * @param sum The checksum before the change.
+ *
+ * @param oldField The old value of the field.
+ *
+ * @param newField The new value of the field.
+ *
+ * @return The checksum after the change.
+ */
+uint16_t ipv4_checksum_update32(uint16_t sum, uint32_t oldField, uint32_t newField);
+
+/**
+ * @brief
+ * Updates an IPv4 header checksum after a field of any length, such as an
+ * IPv6 address in a pseudo-header, changes.
+ *
+ * See ipv4_checksum_update16().  The field must start at an even offset in
+ * the checksummed data.  The cost depends on the length of the field, not
+ * of the data.
+ *
+ * @param sum The checksum before the change.
+ *
+ * @param oldField Pointer to the old contents of the field.
+ *
+ * @param newField Pointer to the new contents of the field.
+ *
+ * @param len The size of the field in bytes.
+ *
+ * @return The checksum after the change.
+ */
+uint16_t ipv4_checksum_update(uint16_t sum, const void* oldField, const void* newField, size_t len);
+
+/**
+ * @brief
+ * Computes the one's complement sum of a block of data, without the final
+ * complement, so that it can be combined with the sums of other blocks.
+ *
+ * The sum of a whole packet is the ipv4_sum_combine() of the sums of its
+ * pieces, and its checksum is the complement of that, ~sum.  For a single
+ * block, ~ipv4_sum_partial() equals ipv4_checksum().
+ *
+ * @param pData Pointer to the block of data.
+ *
+ * @param len The size of the data block in bytes.
+ *
+ * @return The folded 16-bit one's complement sum, in host byte order.
+ */
+uint16_t ipv4_sum_partial(const void* pData, size_t len);
+
+/**
+ * @brief
+ * Copies a block of data and returns the one's complement sum of the bytes
+ * copied.
+ *
+ * Each byte is loaded once, for both the store and the sum, which is
+ * cheaper than memcpy() followed by ipv4_sum_partial() when moving a payload
+ * out of a receive ring or into a transmit buffer.  Long blocks are copied
+ * 32 or 64 bytes at a time with SSE2 or AVX2 when USE_CHECKSUM_SIMD is
+ * defined.  The blocks must not overlap.
+ *
+ * @param dst Pointer to the destination.
+ *
+ * @param src Pointer to the source.
+ *
+ * @param len The number of bytes to copy.
+ *
+ * @return The folded 16-bit one's complement sum of the bytes, as
+ * ipv4_sum_partial() would return for them.
+ */
+uint16_t ipv4_sum_copy(void* dst, const void* src, size_t len);
+
+/**
+ * @brief
+ * Adds the sum of one piece of a packet into the sum of the packet so far.
+ *
+ * A piece that starts at an odd offset in the packet has its bytes in the
+ * other halves of the packet's 16-bit words, so its sum is byte-swapped
+ * before being added.  Pieces may be combined in any order.
+ *
+ * @param sum The sum so far, 0 for none.
+ *
+ * @param part The sum of the piece, from ipv4_sum_partial() or
+ * ipv4_sum_copy().
+ *
+ * @param offset The offset of the piece in the packet, in bytes.
+ *
+ * @return The combined folded 16-bit sum.
+ */
+uint16_t ipv4_sum_combine(uint16_t sum, uint16_t part, size_t offset);
+
+/**
+ * @brief
+ * Computes a TCP or UDP checksum over IPv4, including the pseudo-header.
+ *
+ * The pseudo-header (addresses, protocol and length) is added arithmetically
+ * and the payload is summed in place, segment by segment, so no temporary
+ * copy of the packet is needed.  Segments may have any length; one that
+ * starts at an odd offset in the payload is accounted for.
+ *
+ * The payload is the TCP or UDP header and its data.  With the checksum
+ * field zeroed, the result is the value to store in it, in host byte order
+ * as for ipv4_checksum().  With the received checksum in place, the result
+ * is zero if the packet is intact.  A UDP sender must transmit a computed
+ * zero as 0xFFFF (RFC 768).
+ *
+ * References:
+ *  + "User Datagram Protocol". IETF. August 1980. RFC 768.
+ *
+ *  + "Transmission Control Protocol". IETF. September 1981. RFC 793.
+ *
+ * @param src The 4-byte source address, in network byte order.
+ *
+ * @param dst The 4-byte destination address, in network byte order.
+ *
+ * @param proto The IP protocol number (6 for TCP, 17 for UDP).
+ *
+ * @param iov Pointer to the payload segments.
+ *
+ * @param iovcnt The number of payload segments.
+ *
+ * @return The one's complement checksum.
+ */
+uint16_t l4_checksum_v4(const uint8_t* src, const uint8_t* dst, uint8_t proto,
+                        const struct iovec* iov, int iovcnt);
+
+/**
+ * @brief
+ * Computes a TCP, UDP or ICMPv6 checksum over IPv6, including the
+ * pseudo-header.
+ *
+ * See l4_checksum_v4().  The IPv6 pseudo-header carries a 32-bit length and
+ * the next header value (RFC 8200, section 8.1).
+ *
+ * @param src The 16-byte source address, in network byte order.
+ *
+ * @param dst The 16-byte destination address, in network byte order.
+ *
+ * @param proto The next header value (6 for TCP, 17 for UDP, 58 for ICMPv6).
+ *
+ * @param iov Pointer to the payload segments.
+ *
+ * @param iovcnt The number of payload segments.
+ *
+ * @return The one's complement checksum.
+ */
+uint16_t l4_checksum_v6(const uint8_t* src, const uint8_t* dst, uint8_t proto,
+                        const struct iovec* iov, int iovcnt);
+
 #ifdef __cplusplus
 }
 #endif
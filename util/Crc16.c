@@ -17,6 +17,21 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC16_CalcIov().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added the 16-entry nibble table (see CRC16_USE_NIBBLE).
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC16_Start(), CRC16_Update() and CRC16_Final() for streaming.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC16_Combine().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added slicing-by-8/16 table lookups to CRC16_Calc (see CRC16_SLICE_BY).
+ *
  * 07/24/2015 - Tom Kerr
  * Created.
  ******************************************************************************/
@@ -54,18 +69,43 @@
 /******************************************************************************
  * Forward references.
  ******************************************************************************/
+static uint16_t CRC16_Run(const uint8_t* pdata, size_t size, uint16_t crc);
 static uint16_t CRC16_CalcOneByte(uint8_t data, uint16_t crc);
+static uint16_t CRC16_MultMod(uint16_t a, uint16_t b);
+#if (CRC16_SLICE_BY > 1)
+static uint16_t CRC16_CalcSlice(const uint8_t* pdata, uint16_t crc);
+#endif
 
 
 /******************************************************************************
  * Local definitions.
  ******************************************************************************/
 
+/**
+ * @brief
+ * The CRC-16 polynomial 0x8005, bit-reversed for the right-shift algorithm.
+ */
+#define CRC16_POLY_REFLECTED 0xA001
+
 
 /******************************************************************************
  * Local data.
  ******************************************************************************/
 
+#if defined(CRC16_USE_NIBBLE)
+/**
+ * @brief
+ * CRC calculation look-up table for four bits at a time.
+ *
+ * Contains the intermediate modulo-2 summation of the
+ * calculation for a single nibble.
+ */
+static const uint16_t CRC16_NibbleTable[16] =
+{
+    0x0000, 0xCC01, 0xD801, 0x1400, 0xF001, 0x3C00, 0x2800, 0xE401,
+    0xA001, 0x6C00, 0x7800, 0xB401, 0x5000, 0x9C01, 0x8801, 0x4400
+};
+#else
 /**
  * @brief
  * CRC calculation look-up table.
@@ -108,6 +148,24 @@ static const uint16_t CRC16_Table[256] =
     0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
     0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040,
 };
+#endif
+
+#if (CRC16_SLICE_BY > 1)
+/**
+ * @brief
+ * Slicing-by-N look-up tables.
+ *
+ * CRC16_SliceTable[k-1] holds the CRC of each byte value followed by k
+ * zero bytes.  Built by CRC16_Init().
+ */
+static uint16_t CRC16_SliceTable[CRC16_SLICE_BY - 1][256];
+
+/**
+ * @brief
+ * Non-zero once CRC16_Init() has built CRC16_SliceTable.
+ */
+static uint8_t CRC16_SliceReady = 0;
+#endif
 
 /******************************************************************************
  * Public functions.
@@ -115,35 +173,189 @@ static const uint16_t CRC16_Table[256] =
 
 
 /**************************************
- * CRC16_Calc
+ * CRC16_Init
  **************************************/
-uint16_t CRC16_Calc(const uint8_t* pdata, uint16_t size)
+void CRC16_Init(void)
 {
+#if (CRC16_SLICE_BY > 1)
     uint16_t i;
+    uint16_t k;
     uint16_t crc;
 
-    crc = 0;
+    for (i = 0; i < 256; i++)
+    {
+        crc = CRC16_Table[i];
+        for (k = 0; k < CRC16_SLICE_BY - 1; k++)
+        {
+            crc = CRC16_CalcOneByte(0, crc);
+            CRC16_SliceTable[k][i] = crc;
+        }
+    }
+    CRC16_SliceReady = 1;
+#endif
+}
 
-    for (i=0; i < size; i++)
+
+/**************************************
+ * CRC16_Calc
+ **************************************/
+uint16_t CRC16_Calc(const uint8_t* pdata, size_t size)
+{
+    return CRC16_Run(pdata, size, 0);
+}
+
+
+/**************************************
+ * CRC16_CalcIov
+ **************************************/
+uint16_t CRC16_CalcIov(const struct iovec* iov, int iovcnt)
+{
+    uint16_t crc = 0;
+    int      i;
+
+    for (i = 0; i < iovcnt; i++)
     {
-        crc = CRC16_CalcOneByte(*pdata++, crc);
+        crc = CRC16_Run((const uint8_t*)iov[i].iov_base, iov[i].iov_len, crc);
     }
     return crc;
 }
 
 
+/**************************************
+ * CRC16_Start
+ **************************************/
+void CRC16_Start(CRC16_CTX* ctx)
+{
+    ctx->crc = 0;
+}
+
+
+/**************************************
+ * CRC16_Update
+ **************************************/
+void CRC16_Update(CRC16_CTX* ctx, const uint8_t* pdata, size_t size)
+{
+    ctx->crc = CRC16_Run(pdata, size, ctx->crc);
+}
+
+
+/**************************************
+ * CRC16_Final
+ **************************************/
+uint16_t CRC16_Final(const CRC16_CTX* ctx)
+{
+    // Zero seed and no final XOR: the running CRC is the result.
+    return ctx->crc;
+}
+
+
+/**************************************
+ * CRC16_Combine
+ **************************************/
+uint16_t CRC16_Combine(uint16_t crcA, uint16_t crcB, size_t sizeB)
+{
+    uint16_t xpow   = 0x8000;  // x^0, reflected
+    uint16_t square = 0x0080;  // x^8, reflected
+
+    // The seed is zero, so CRC(A + B) = CRC(A) * x^(8 * sizeB) + CRC(B).
+    for (; sizeB != 0; sizeB >>= 1)
+    {
+        if (sizeB & 1)
+        {
+            xpow = CRC16_MultMod(xpow, square);
+        }
+        square = CRC16_MultMod(square, square);
+    }
+    return CRC16_MultMod(crcA, xpow) ^ crcB;
+}
+
+
 /******************************************************************************
  * Private functions.
  ******************************************************************************/
  
+/**************************************
+ * CRC16_Run
+ **************************************/
+static uint16_t CRC16_Run(const uint8_t* pdata, size_t size, uint16_t crc)
+{
+#if (CRC16_SLICE_BY > 1)
+    if (CRC16_SliceReady)
+    {
+        for (; size >= CRC16_SLICE_BY; size -= CRC16_SLICE_BY)
+        {
+            crc = CRC16_CalcSlice(pdata, crc);
+            pdata += CRC16_SLICE_BY;
+        }
+    }
+#endif
+
+    for (; size > 0; size--)
+    {
+        crc = CRC16_CalcOneByte(*pdata++, crc);
+    }
+    return crc;
+}
+
+
 /**************************************
  * CRC16_CalcOneByte
  **************************************/
 static uint16_t CRC16_CalcOneByte(uint8_t data, uint16_t crc)
 {
+#if defined(CRC16_USE_NIBBLE)
+    crc ^= data;
+    crc = (crc >> 4) ^ CRC16_NibbleTable[crc & 0x000f];
+    crc = (crc >> 4) ^ CRC16_NibbleTable[crc & 0x000f];
+#else
     uint16_t index = ((crc ^ (uint16_t)data) & 0x00ff);
     crc = ((crc >> 8) & 0x00ff) ^ CRC16_Table[index];
+#endif
     return crc;
 } 
+
+
+/**************************************
+ * CRC16_MultMod
+ **************************************/
+static uint16_t CRC16_MultMod(uint16_t a, uint16_t b)
+{
+    uint16_t product = 0;
+    uint16_t bit;
+
+    // Reflected polynomials: bit 15 holds x^0, bit 0 holds x^15.
+    for (bit = 0x8000; bit != 0; bit >>= 1)
+    {
+        if (a & bit)
+        {
+            product ^= b;
+        }
+        b = (b & 1) ? ((b >> 1) ^ CRC16_POLY_REFLECTED) : (b >> 1);
+    }
+    return product;
+}
+
+
+#if (CRC16_SLICE_BY > 1)
+/**************************************
+ * CRC16_CalcSlice
+ **************************************/
+static uint16_t CRC16_CalcSlice(const uint8_t* pdata, uint16_t crc)
+{
+    uint16_t result;
+    uint8_t  i;
+
+    // The first two bytes absorb the running CRC (low byte first); every
+    // byte is then looked up by the number of bytes that follow it.
+    result = CRC16_Table[pdata[CRC16_SLICE_BY - 1]];
+    result ^= CRC16_SliceTable[CRC16_SLICE_BY - 2][(uint8_t)(pdata[0] ^ crc)];
+    result ^= CRC16_SliceTable[CRC16_SLICE_BY - 3][(uint8_t)(pdata[1] ^ (crc >> 8))];
+    for (i = 2; i < CRC16_SLICE_BY - 1; i++)
+    {
+        result ^= CRC16_SliceTable[CRC16_SLICE_BY - 2 - i][pdata[i]];
+    }
+    return result;
+}
+#endif
  
 // End of file.
@@ -17,6 +17,22 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC16_CalcIov().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC16_USE_NIBBLE and CRC16_TABLE_BYTES.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC16_Start(), CRC16_Update() and CRC16_Final() for streaming.
+ * CRC16_Calc() size is now size_t.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC16_Combine().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC16_SLICE_BY and CRC16_Init() for slicing-by-8/16.
+ *
  * 07/24/2015 - Tom Kerr
  * Created.
  ******************************************************************************/
@@ -46,18 +62,72 @@
 /******************************************************************************
  * System include files.
  ******************************************************************************/
+#include <stddef.h>
 #include <stdint.h>
 
 
 /******************************************************************************
  * Local include files.
  ******************************************************************************/
+#include "Iovec.h"
 
 
 /******************************************************************************
 * Public definitions.
 ******************************************************************************/
 
+/**
+ * @brief
+ * Number of data bytes CRC16_Calc() consumes per iteration: 1 (byte-wise
+ * table), 8 or 16 (slicing-by-N).
+ *
+ * Slicing-by-N builds N-1 additional 512 byte tables in RAM when
+ * CRC16_Init() is called, so it defaults to 1 on AVR and 8 everywhere else.
+ */
+#if !defined(CRC16_SLICE_BY)
+#if defined(__AVR__)
+#define CRC16_SLICE_BY 1
+#else
+#define CRC16_SLICE_BY 8
+#endif
+#endif
+
+#if (CRC16_SLICE_BY != 1) && (CRC16_SLICE_BY != 8) && (CRC16_SLICE_BY != 16)
+#error "CRC16_SLICE_BY must be 1, 8, or 16."
+#endif
+
+/**
+ * @brief
+ * Define CRC16_USE_NIBBLE to replace the 512 byte look-up table with a
+ * 32 byte one that is consulted twice per byte, for parts where flash is
+ * tight.  Roughly half the speed of the byte-wise table.  Requires
+ * CRC16_SLICE_BY 1.
+ */
+//#define CRC16_USE_NIBBLE
+
+#if defined(CRC16_USE_NIBBLE) && (CRC16_SLICE_BY != 1)
+#error "CRC16_USE_NIBBLE requires CRC16_SLICE_BY 1."
+#endif
+
+/**
+ * @brief
+ * Memory used by the CRC16_Calc() look-up tables, in bytes.
+ */
+#if defined(CRC16_USE_NIBBLE)
+#define CRC16_TABLE_BYTES (16 * sizeof(uint16_t))
+#else
+#define CRC16_TABLE_BYTES (CRC16_SLICE_BY * 256 * sizeof(uint16_t))
+#endif
+
+/**
+ * @brief
+ * Running CRC-16 calculation over data that arrives in pieces.
+ */
+typedef struct _CRC16_CTX
+{
+    uint16_t crc;  //!< CRC-16 of the data so far
+} CRC16_CTX;
+
 
 /******************************************************************************
  * Public functions.
@@ -68,6 +138,16 @@ extern "C" {
 #endif
 
 
+/**
+ * @brief
+ * Builds the slicing-by-N lookup tables selected by CRC16_SLICE_BY.
+ *
+ * Optional.  Until it has been called, CRC16_Calc() uses the byte-wise
+ * table and returns the same results, only more slowly.  Call it once at
+ * startup, before any concurrent use of CRC16_Calc().
+ */
+void CRC16_Init(void);
+
 /**
  * @brief
  * Calculates the CRC-16 value of the specified data array.
@@ -80,7 +160,75 @@ extern "C" {
  *
  * @return The CRC-16 value of the data array.
  */
-uint16_t CRC16_Calc(const uint8_t* pdata, uint16_t size);
+uint16_t CRC16_Calc(const uint8_t* pdata, size_t size);
+
+/**
+ * @brief
+ * Calculates the CRC-16 value of data held in a list of segments.
+ *
+ * Equal to CRC16_Calc() over the segments gathered into one array, without
+ * gathering them.
+ *
+ * @param iov Pointer to an array of segments.
+ *
+ * @param iovcnt The number of segments.
+ *
+ * @return The CRC-16 value of the segments, in order.
+ */
+uint16_t CRC16_CalcIov(const struct iovec* iov, int iovcnt);
+
+/**
+ * @brief
+ * Starts a running CRC-16 calculation.
+ *
+ * @param ctx Pointer to the context to initialize.
+ */
+void CRC16_Start(CRC16_CTX* ctx);
+
+/**
+ * @brief
+ * Adds the next piece of data to a running CRC-16 calculation.
+ *
+ * Feeding a data array through any number of CRC16_Update() calls gives
+ * the same result as one CRC16_Calc() over the whole array.
+ *
+ * @param ctx Pointer to the context.
+ *
+ * @param pdata Pointer to the next data bytes.
+ *
+ * @param size The number of bytes.
+ */
+void CRC16_Update(CRC16_CTX* ctx, const uint8_t* pdata, size_t size);
+
+/**
+ * @brief
+ * Returns the CRC-16 value of all data added so far.
+ *
+ * The context is not modified, so more data may still be added.
+ *
+ * @param ctx Pointer to the context.
+ *
+ * @return The CRC-16 value.
+ */
+uint16_t CRC16_Final(const CRC16_CTX* ctx);
+
+/**
+ * @brief
+ * Combines the CRC-16 values of two data arrays into the CRC-16 value of
+ * the two arrays concatenated.
+ *
+ * Runs in O(log sizeB) without touching the data, so independently
+ * computed pieces of a large array can be merged.
+ *
+ * @param crcA The CRC-16 value of the first array.
+ *
+ * @param crcB The CRC-16 value of the second array.
+ *
+ * @param sizeB The size of the second array in bytes.
+ *
+ * @return The CRC-16 value of the first array followed by the second.
+ */
+uint16_t CRC16_Combine(uint16_t crcA, uint16_t crcB, size_t sizeB);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,176 @@
+/******************************************************************************
+ * CrcParallel.c
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Multi-threaded CRC of large buffers and files.
+ */
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "CrcParallel.h"
+
+
+/******************************************************************************
+ * Forward references.
+ ******************************************************************************/
+static void crcParallelTask(void* arg, size_t index);
+
+
+/******************************************************************************
+ * Local definitions.
+ ******************************************************************************/
+
+/**
+ * @brief
+ * Number of chunks per thread, so that threads finishing early can pick up
+ * more work.
+ */
+#define CHUNKS_PER_THREAD 4
+
+/**
+ * @brief
+ * One parallel CRC job.
+ */
+typedef struct
+{
+    const uint8_t* message;    //!< Start of the data
+    size_t         nBytes;     //!< Size of the data
+    size_t         chunkSize;  //!< Size of every chunk but the last
+    crc_t*         crcs;       //!< CRC of each chunk
+} CRC_PARALLEL_JOB;
+
+
+/******************************************************************************
+ * Local data.
+ ******************************************************************************/
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+/**************************************
+ * crcParallel
+ **************************************/
+crc_t crcParallel(THREADPOOL* pool, const uint8_t* message, size_t nBytes)
+{
+    CRC_PARALLEL_JOB job;
+    size_t           numChunks;
+    size_t           i;
+    crc_t            crc;
+
+    job.chunkSize = nBytes / ((size_t)THREADPOOL_Size(pool) * CHUNKS_PER_THREAD);
+    if (job.chunkSize < CRC_PARALLEL_MIN_CHUNK)
+    {
+        job.chunkSize = CRC_PARALLEL_MIN_CHUNK;
+    }
+    numChunks = (nBytes + job.chunkSize - 1) / job.chunkSize;
+
+    job.crcs = NULL;
+    if (numChunks >= 2)
+    {
+        job.crcs = (crc_t*)malloc(numChunks * sizeof(crc_t));
+    }
+    if (job.crcs == NULL)
+    {
+        return crcFast(message, nBytes);
+    }
+
+    job.message = message;
+    job.nBytes  = nBytes;
+    THREADPOOL_Run(pool, crcParallelTask, &job, numChunks);
+
+    // Stitch the chunk CRCs together in order.
+    crc = job.crcs[0];
+    for (i = 1; i < numChunks - 1; i++)
+    {
+        crc = crc_combine(crc, job.crcs[i], job.chunkSize);
+    }
+    crc = crc_combine(crc, job.crcs[i], nBytes - i * job.chunkSize);
+
+    free(job.crcs);
+    return crc;
+}
+
+
+/**************************************
+ * crcParallelFile
+ **************************************/
+int crcParallelFile(THREADPOOL* pool, const char* path, crc_t* crc)
+{
+    struct stat st;
+    void*       map;
+    int         fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    if ((fstat(fd, &st) != 0) || (st.st_size < 0))
+    {
+        close(fd);
+        return -1;
+    }
+
+    if (st.st_size == 0)
+    {
+        close(fd);
+        *crc = crcFast(NULL, 0);
+        return 0;
+    }
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+    *crc = crcParallel(pool, (const uint8_t*)map, (size_t)st.st_size);
+
+    munmap(map, (size_t)st.st_size);
+    return 0;
+}
+
+
+/******************************************************************************
+ * Private functions.
+ ******************************************************************************/
+
+/**************************************
+ * crcParallelTask
+ **************************************/
+static void crcParallelTask(void* arg, size_t index)
+{
+    CRC_PARALLEL_JOB* job    = (CRC_PARALLEL_JOB*)arg;
+    size_t            offset = index * job->chunkSize;
+    size_t            len    = job->nBytes - offset;
+
+    if (len > job->chunkSize)
+    {
+        len = job->chunkSize;
+    }
+    job->crcs[index] = crcFast(job->message + offset, len);
+}
+
+// End of file.
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * CrcParallel.h
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Multi-threaded CRC of large buffers and files.
+ *
+ * The data is cut into chunks whose CRCs are computed with crcFast() on a
+ * thread pool and merged in order with crc_combine().  The result is the
+ * same CRC that crcFast() returns over the whole buffer, for whichever
+ * standard is selected in crc.h.
+ *
+ * crcInit() must be called first.  Intended for host builds with pthreads
+ * and mmap; see ThreadPool.h.
+ */
+
+#ifndef _CRC_PARALLEL_H
+#define _CRC_PARALLEL_H
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "crc.h"
+#include "ThreadPool.h"
+
+
+/******************************************************************************
+ * Public definitions.
+ ******************************************************************************/
+
+/**
+ * @brief
+ * Smallest chunk handed to a thread.  Below two chunks the buffer is
+ * simply run through crcFast() on the calling thread.
+ */
+#define CRC_PARALLEL_MIN_CHUNK (1024 * 1024)
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Computes the CRC of a buffer on a thread pool.
+ *
+ * @param pool The thread pool to run on
+ *
+ * @param message Pointer to the data
+ *
+ * @param nBytes The size of the data in bytes
+ *
+ * @return The CRC of the data, identical to crcFast(message, nBytes).
+ */
+crc_t crcParallel(THREADPOOL* pool, const uint8_t* message, size_t nBytes);
+
+/**
+ * @brief
+ * Computes the CRC of a file on a thread pool.
+ *
+ * The file is memory mapped read-only, so it is read straight from the
+ * page cache without copying.
+ *
+ * @param pool The thread pool to run on
+ *
+ * @param path Path of the file
+ *
+ * @param crc Receives the CRC of the file contents
+ *
+ * @return 0 on success, -1 if the file could not be opened or mapped.
+ */
+int crcParallelFile(THREADPOOL* pool, const char* path, crc_t* crc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CRC_PARALLEL_H
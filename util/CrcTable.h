@@ -0,0 +1,299 @@
+/******************************************************************************
+ * CrcTable.h
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added calc() over a list of segments.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC-64/ECMA-182 and CRC-64/XZ.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Compile-time CRC lookup tables and CRCs of string literals for C++.
+ *
+ * The Crc class template takes the same parameters as the standards in
+ * crc.h and builds its 256-entry lookup table with constexpr code, so the
+ * table is placed in read-only memory by the compiler.  There is no
+ * crcInit() step to forget and nothing to race on at startup.
+ *
+ * Crc<...>::literal() computes the CRC of a string literal at compile
+ * time (consteval with C++20, constexpr before), for hashing command IDs
+ * and other constant keys:
+ *
+ * @code
+ * switch (Crc32::calc(cmd, len))
+ * {
+ *     case Crc32::literal("SET_MODE"): ...
+ * }
+ * @endcode
+ *
+ * Requires C++14.
+ */
+
+#ifndef _CRC_TABLE_H
+#define _CRC_TABLE_H
+
+#if !defined(__cplusplus) || (__cplusplus < 201402L)
+#error "CrcTable.h requires C++14 or later."
+#endif
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "Iovec.h"
+
+
+/******************************************************************************
+ * Public definitions.
+ ******************************************************************************/
+
+/**
+ * @brief
+ * Expands to consteval where the compiler supports it, so that
+ * Crc<...>::literal() can only run at compile time.
+ */
+#if defined(__cpp_consteval)
+#define CRC_CONSTEVAL consteval
+#else
+#define CRC_CONSTEVAL constexpr
+#endif
+
+
+/******************************************************************************
+ * Public classes.
+ ******************************************************************************/
+
+/**
+ * @class Crc
+ * A CRC standard with a compile-time lookup table.
+ *
+ * @tparam T Unsigned type of the CRC, which sets its width.
+ * @tparam Polynomial The generator polynomial, without its top bit.
+ * @tparam InitialRemainder Initial value of the remainder.
+ * @tparam FinalXorValue Value XOR-ed into the final remainder.
+ * @tparam ReflectData Non-zero if message bytes are processed LSB first.
+ * @tparam ReflectRemainder Non-zero if the final remainder is reflected.
+ */
+template <typename T, T Polynomial, T InitialRemainder, T FinalXorValue,
+          bool ReflectData, bool ReflectRemainder>
+class Crc
+{
+public:
+
+    /**
+     * @brief
+     * The lookup table type.
+     */
+    struct Table
+    {
+        T entry[256];  //!< Remainder of each byte value
+    };
+
+    /**
+     * @brief
+     * The lookup table, built at compile time.
+     *
+     * For reflected standards it is the reflected (right-shift) table.
+     */
+    static constexpr Table table = Crc::makeTable();
+
+    /**
+     * @brief
+     * Computes the CRC of a message.
+     *
+     * Usable at compile time and at run time.
+     *
+     * @param message Pointer to the message.
+     * @param nBytes The size of the message in bytes.
+     * @return The CRC of the message.
+     */
+    static constexpr T calc(const uint8_t* message, size_t nBytes)
+    {
+        return finish(update(StartRemainder, message, nBytes));
+    }
+
+    /**
+     * @brief
+     * Computes the CRC of a character string.
+     *
+     * @param str Pointer to the characters.
+     * @param nBytes The number of characters.
+     * @return The CRC of the characters.
+     */
+    static constexpr T calc(const char* str, size_t nBytes)
+    {
+        T remainder = StartRemainder;
+        for (size_t i = 0; i < nBytes; ++i)
+        {
+            remainder = step(remainder, static_cast<uint8_t>(str[i]));
+        }
+        return finish(remainder);
+    }
+
+    /**
+     * @brief
+     * Computes the CRC of a message held in a list of segments, without
+     * gathering them.  Run time only.
+     *
+     * @param iov Pointer to an array of segments.
+     * @param iovcnt The number of segments.
+     * @return The CRC of the segments, in order.
+     */
+    static T calc(const struct iovec* iov, int iovcnt)
+    {
+        T remainder = StartRemainder;
+        for (int i = 0; i < iovcnt; ++i)
+        {
+            remainder = update(remainder, static_cast<const uint8_t*>(iov[i].iov_base), iov[i].iov_len);
+        }
+        return finish(remainder);
+    }
+
+    /**
+     * @brief
+     * Computes the CRC of a string literal at compile time.
+     *
+     * The terminating NUL is not included.
+     *
+     * @param str The string literal.
+     * @return The CRC of the string.
+     */
+    template <size_t N>
+    static CRC_CONSTEVAL T literal(const char (&str)[N])
+    {
+        return calc(str, N - 1);
+    }
+
+private:
+
+    static constexpr unsigned Width = 8 * sizeof(T);
+    static constexpr T TopBit = static_cast<T>(static_cast<T>(1) << (Width - 1));
+
+    /**
+     * @brief
+     * Reflects the low nBits bits of a value.
+     */
+    static constexpr T reflect(T value, unsigned nBits)
+    {
+        T reflection = 0;
+        for (unsigned bit = 0; bit < nBits; ++bit)
+        {
+            if (value & 1)
+            {
+                reflection |= static_cast<T>(static_cast<T>(1) << (nBits - 1 - bit));
+            }
+            value = static_cast<T>(value >> 1);
+        }
+        return reflection;
+    }
+
+    static constexpr T ReflectedPolynomial = Crc::reflect(Polynomial, Width);
+    static constexpr T StartRemainder = ReflectData ? Crc::reflect(InitialRemainder, Width) : InitialRemainder;
+
+    /**
+     * @brief
+     * Divides one byte value by the polynomial, a bit at a time.
+     */
+    static constexpr T entry(unsigned byte)
+    {
+        T remainder = ReflectData ? static_cast<T>(byte)
+                                  : static_cast<T>(static_cast<T>(byte) << (Width - 8));
+        for (unsigned bit = 0; bit < 8; ++bit)
+        {
+            if (ReflectData)
+            {
+                remainder = (remainder & 1) ? static_cast<T>((remainder >> 1) ^ ReflectedPolynomial)
+                                            : static_cast<T>(remainder >> 1);
+            }
+            else
+            {
+                remainder = (remainder & TopBit) ? static_cast<T>((remainder << 1) ^ Polynomial)
+                                                 : static_cast<T>(remainder << 1);
+            }
+        }
+        return remainder;
+    }
+
+    static constexpr Table makeTable()
+    {
+        Table t = {};
+        for (unsigned byte = 0; byte < 256; ++byte)
+        {
+            t.entry[byte] = entry(byte);
+        }
+        return t;
+    }
+
+    /**
+     * @brief
+     * Divides one message byte into the remainder.
+     *
+     * Reflected standards keep the remainder reflected and shift right, so
+     * no per-byte reflection is needed.
+     */
+    static constexpr T step(T remainder, uint8_t data)
+    {
+        return ReflectData
+            ? static_cast<T>(table.entry[static_cast<uint8_t>(remainder ^ data)] ^ (Width > 8 ? (remainder >> 8) : 0))
+            : static_cast<T>(table.entry[static_cast<uint8_t>((remainder >> (Width - 8)) ^ data)] ^ (Width > 8 ? (remainder << 8) : 0));
+    }
+
+    static constexpr T update(T remainder, const uint8_t* message, size_t nBytes)
+    {
+        for (size_t i = 0; i < nBytes; ++i)
+        {
+            remainder = step(remainder, message[i]);
+        }
+        return remainder;
+    }
+
+    static constexpr T finish(T remainder)
+    {
+        // A reflected remainder only needs turning around when the two
+        // reflect flags differ.
+        return static_cast<T>((ReflectData != ReflectRemainder ? reflect(remainder, Width) : remainder) ^ FinalXorValue);
+    }
+};
+
+// Out-of-class definition of the table, needed before C++17.
+template <typename T, T P, T I, T X, bool RD, bool RR>
+constexpr typename Crc<T, P, I, X, RD, RR>::Table Crc<T, P, I, X, RD, RR>::table;
+
+
+/******************************************************************************
+ * Standards from crc.h.
+ ******************************************************************************/
+
+typedef Crc<uint16_t, 0x1021, 0xFFFF, 0x0000, false, false> CrcCcitt;   //!< CRC-CCITT
+typedef Crc<uint16_t, 0x8005, 0x0000, 0x0000, true, true> Crc16;        //!< CRC-16
+typedef Crc<uint32_t, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true> Crc32;   //!< CRC-32
+typedef Crc<uint32_t, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true, true> Crc32c;  //!< CRC-32C
+typedef Crc<uint64_t, 0x42F0E1EBA9EA3693ULL, 0, 0, false, false> Crc64Ecma;      //!< CRC-64/ECMA-182
+typedef Crc<uint64_t, 0x42F0E1EBA9EA3693ULL, ~0ULL, ~0ULL, true, true> Crc64Xz;  //!< CRC-64/XZ
+
+static_assert(CrcCcitt::literal("123456789") == 0x29B1, "CRC-CCITT check value");
+static_assert(Crc16::literal("123456789") == 0xBB3D, "CRC-16 check value");
+static_assert(Crc32::literal("123456789") == 0xCBF43926, "CRC-32 check value");
+static_assert(Crc32c::literal("123456789") == 0xE3069283, "CRC-32C check value");
+static_assert(Crc64Ecma::literal("123456789") == 0x6C40DF5F0B497347ULL, "CRC-64/ECMA-182 check value");
+static_assert(Crc64Xz::literal("123456789") == 0x995DC9BBDF1939FAULL, "CRC-64/XZ check value");
+
+#endif // _CRC_TABLE_H
@@ -7,6 +7,9 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added add() with a running CRC, if USE_FIFO_CRC is defined.
+ *
  * 07/24/2015 - Tom Kerr
  * Created.
  ******************************************************************************/
@@ -123,6 +126,42 @@ uint16_t Fifo::add(const uint8_t* source, uint16_t count)
 }
 
 
+#if defined(USE_FIFO_CRC)
+/**************************************
+ * Fifo::add
+ **************************************/
+uint16_t Fifo::add(const uint8_t* source, uint16_t count, CRC_CTX* ctx)
+{
+    uint16_t numadded;
+    uint16_t run;
+
+    // limit the number to add to the available space
+    if (count > available())
+    {
+        count = available();
+    }
+    numadded = count;
+    mCount += count;
+
+    // copy up to the end of the buffer, then wrap for the rest
+    run = (uint16_t)(mEnd - mTail);
+    if (run > count)
+    {
+        run = count;
+    }
+    crc_copy(mTail, source, run, ctx);
+    mTail += run;
+    if (mTail == mEnd)
+    {
+        mTail = mBuffer;
+    }
+    crc_copy(mTail, source + run, count - run, ctx);
+    mTail += count - run;
+    return numadded;
+}
+#endif
+
+
 /**************************************
  * Fifo::remove
  **************************************/
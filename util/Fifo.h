@@ -7,6 +7,9 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added add() with a running CRC, if USE_FIFO_CRC is defined.
+ *
  * 07/26/2015 - Tom Kerr
  * Doxygen updates.
  *
@@ -39,6 +42,17 @@
 * Public definitions.
 ******************************************************************************/
 
+/*
+ * If USE_FIFO_CRC is defined, the Fifo class has an add() that also updates
+ * a running CRC (see crc.h).  The program must then also link crc.c.  Off
+ * by default so that the FIFO does not depend on the CRC module.
+ */
+//#define USE_FIFO_CRC
+
+#if defined(USE_FIFO_CRC)
+#include "crc.h"
+#endif
+
 
 /******************************************************************************
  * Public classes.
@@ -102,6 +116,24 @@ public:
      */
     uint16_t add(const uint8_t* source, uint16_t count);
 
+    /**
+     * @brief
+     * Adds bytes to the FIFO at the tail and adds the same bytes to a
+     * running CRC, in one pass over the source (see crc_copy()).
+     *
+     * Only the bytes actually added are included in the CRC.  Requires
+     * crcInit() and a context started with crc_init().  Only built if
+     * USE_FIFO_CRC is defined.
+     *
+     * @param source Pointer to source data.
+     * @param count The number of bytes to add.
+     * @param ctx The running CRC.
+     * @return The number of bytes added to the FIFO.
+     */
+#if defined(USE_FIFO_CRC)
+    uint16_t add(const uint8_t* source, uint16_t count, CRC_CTX* ctx);
+#endif
+
     /**
      * @brief
      * Removes up to max bytes from the head of the FIFO, placing the bytes at
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Iovec.h
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Provides struct iovec, the scatter/gather segment descriptor, on every
+ * target.
+ *
+ * POSIX hosts get it from <sys/uio.h>, so segment lists built for readv()
+ * and writev() can be passed straight to the scatter/gather functions in
+ * this library.  Targets without <sys/uio.h>, such as the Arduino, get a
+ * definition with the same members.
+ */
+
+#ifndef _IOVEC_H
+#define _IOVEC_H
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stddef.h>
+
+#if defined(__AVR__) || defined(_WIN32)
+
+/**
+ * @brief
+ * One segment of a scatter/gather list.
+ */
+struct iovec
+{
+    void*  iov_base;  //!< Start of the segment
+    size_t iov_len;   //!< Length of the segment in bytes
+};
+
+#else
+#include <sys/uio.h>
+#endif
+
+
+#endif // _IOVEC_H
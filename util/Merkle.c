@@ -0,0 +1,479 @@
+/******************************************************************************
+ * Merkle.c
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added leaf updates.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * SHA-256 Merkle trees of large buffers and files, built on a thread pool.
+ */
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "Merkle.h"
+
+
+/******************************************************************************
+ * Forward references.
+ ******************************************************************************/
+static void merkleLeafTask(void* arg, size_t index);
+static void merkleParentTask(void* arg, size_t index);
+static void merkleParents(MERKLE_TREE* tree, int level, size_t first, size_t last);
+static void merkleLeaf(MERKLE_TREE* tree, size_t leaf, const uint8_t* data);
+static int merkleCompare(const void* a, const void* b);
+
+
+/******************************************************************************
+ * Local definitions.
+ ******************************************************************************/
+
+/**
+ * @brief
+ * Number of leaf and parent tasks per thread, so that threads finishing
+ * early can pick up more work.
+ */
+#define TASKS_PER_THREAD 4
+
+/**
+ * @brief
+ * Number of leaves passed to sha256_many() at a time.
+ */
+#define LEAF_GROUP 64
+
+/**
+ * @brief
+ * One parallel run over the leaves or over the parents of one level.
+ */
+typedef struct
+{
+    MERKLE_TREE*   tree;          //!< The tree being built
+    const uint8_t* data;          //!< Start of the data
+    size_t         len;           //!< Size of the data
+    int            level;         //!< Level whose nodes are computed
+    size_t         nodesPerTask;  //!< Nodes computed by each task
+} MERKLE_JOB;
+
+
+/******************************************************************************
+ * Local data.
+ ******************************************************************************/
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+/**************************************
+ * MERKLE_Build
+ **************************************/
+int MERKLE_Build(THREADPOOL* pool, MERKLE_TREE* tree, const uint8_t* data, size_t len, size_t leafSize)
+{
+    MERKLE_JOB job;
+    size_t     count;
+    size_t     total;
+    size_t     numTasks;
+    int        level;
+
+    tree->nodes     = NULL;
+    tree->dirty     = NULL;
+    tree->numDirty  = 0;
+    tree->dirtySize = 0;
+    if (leafSize == 0) return -1;
+
+    tree->len       = len;
+    tree->leafSize  = leafSize;
+    tree->numLeaves = (len == 0) ? 1 : (len - 1) / leafSize + 1;
+
+    // Lay out the levels one after another, the leaves first.
+    count = tree->numLeaves;
+    total = 0;
+    for (level = 0; ; level++)
+    {
+        tree->levelStart[level] = total;
+        tree->levelCount[level] = count;
+        total += count;
+        if (count == 1) break;
+        count = (count + 1) / 2;
+    }
+    tree->numLevels = level + 1;
+
+    tree->nodes = (uint8_t(*)[SHA256_BLOCK_SIZE])malloc(total * SHA256_BLOCK_SIZE);
+    if (tree->nodes == NULL) return -1;
+
+    job.tree = tree;
+    job.data = data;
+    job.len  = len;
+
+    job.level        = 0;
+    job.nodesPerTask = tree->numLeaves / ((size_t)THREADPOOL_Size(pool) * TASKS_PER_THREAD);
+    if (job.nodesPerTask == 0)
+    {
+        job.nodesPerTask = 1;
+    }
+    numTasks = (tree->numLeaves + job.nodesPerTask - 1) / job.nodesPerTask;
+    THREADPOOL_Run(pool, merkleLeafTask, &job, numTasks);
+
+    for (level = 1; level < tree->numLevels; level++)
+    {
+        count = tree->levelCount[level];
+        if (count < MERKLE_PARALLEL_PARENTS)
+        {
+            merkleParents(tree, level, 0, count);
+            continue;
+        }
+        job.level        = level;
+        job.nodesPerTask = count / ((size_t)THREADPOOL_Size(pool) * TASKS_PER_THREAD);
+        if (job.nodesPerTask < MERKLE_PARALLEL_PARENTS / TASKS_PER_THREAD)
+        {
+            job.nodesPerTask = MERKLE_PARALLEL_PARENTS / TASKS_PER_THREAD;
+        }
+        numTasks = (count + job.nodesPerTask - 1) / job.nodesPerTask;
+        THREADPOOL_Run(pool, merkleParentTask, &job, numTasks);
+    }
+
+    return 0;
+}
+
+
+/**************************************
+ * MERKLE_BuildFile
+ **************************************/
+int MERKLE_BuildFile(THREADPOOL* pool, MERKLE_TREE* tree, const char* path, size_t leafSize)
+{
+    struct stat st;
+    void*       map;
+    int         fd;
+    int         status;
+
+    tree->nodes = NULL;
+    tree->dirty = NULL;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    if ((fstat(fd, &st) != 0) || (st.st_size < 0))
+    {
+        close(fd);
+        return -1;
+    }
+
+    if (st.st_size == 0)
+    {
+        close(fd);
+        return MERKLE_Build(pool, tree, NULL, 0, leafSize);
+    }
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+    status = MERKLE_Build(pool, tree, (const uint8_t*)map, (size_t)st.st_size, leafSize);
+
+    munmap(map, (size_t)st.st_size);
+    return status;
+}
+
+
+/**************************************
+ * MERKLE_Update
+ **************************************/
+int MERKLE_Update(MERKLE_TREE* tree, size_t leaf, const uint8_t* data)
+{
+    int level;
+
+    if (leaf >= tree->numLeaves) return -1;
+
+    merkleLeaf(tree, leaf, data);
+    for (level = 1; level < tree->numLevels; level++)
+    {
+        leaf /= 2;
+        merkleParents(tree, level, leaf, leaf + 1);
+    }
+    return 0;
+}
+
+
+/**************************************
+ * MERKLE_SetLeaf
+ **************************************/
+int MERKLE_SetLeaf(MERKLE_TREE* tree, size_t leaf, const uint8_t* data)
+{
+    size_t* dirty;
+    size_t  size;
+
+    if (leaf >= tree->numLeaves) return -1;
+
+    if (tree->numDirty == tree->dirtySize)
+    {
+        size  = (tree->dirtySize == 0) ? 64 : 2 * tree->dirtySize;
+        dirty = (size_t*)realloc(tree->dirty, size * sizeof(size_t));
+        if (dirty == NULL) return -1;
+        tree->dirty     = dirty;
+        tree->dirtySize = size;
+    }
+
+    merkleLeaf(tree, leaf, data);
+    tree->dirty[tree->numDirty++] = leaf;
+    return 0;
+}
+
+
+/**************************************
+ * MERKLE_Commit
+ **************************************/
+void MERKLE_Commit(MERKLE_TREE* tree)
+{
+    size_t* dirty = tree->dirty;
+    size_t  n     = tree->numDirty;
+    size_t  i;
+    size_t  j;
+    int     level;
+
+    if (n == 0) return;
+
+    // Sorted, the nodes with a common parent are next to each other, so
+    // each level's list of parents to rehash is made in place, without
+    // duplicates, from the list of the level below.
+    qsort(dirty, n, sizeof(size_t), merkleCompare);
+    for (level = 1; level < tree->numLevels; level++)
+    {
+        for (i = 0, j = 0; i < n; i++)
+        {
+            if ((j == 0) || (dirty[j - 1] != dirty[i] / 2))
+            {
+                dirty[j++] = dirty[i] / 2;
+            }
+        }
+        n = j;
+        for (i = 0; i < n; i++)
+        {
+            merkleParents(tree, level, dirty[i], dirty[i] + 1);
+        }
+    }
+    tree->numDirty = 0;
+}
+
+
+/**************************************
+ * MERKLE_Free
+ **************************************/
+void MERKLE_Free(MERKLE_TREE* tree)
+{
+    free(tree->nodes);
+    free(tree->dirty);
+    tree->nodes     = NULL;
+    tree->dirty     = NULL;
+    tree->numDirty  = 0;
+    tree->dirtySize = 0;
+}
+
+
+/**************************************
+ * MERKLE_Root
+ **************************************/
+const uint8_t* MERKLE_Root(const MERKLE_TREE* tree)
+{
+    return tree->nodes[tree->levelStart[tree->numLevels - 1]];
+}
+
+
+/**************************************
+ * MERKLE_Proof
+ **************************************/
+int MERKLE_Proof(const MERKLE_TREE* tree, size_t leaf, uint8_t path[][SHA256_BLOCK_SIZE])
+{
+    size_t index = leaf;
+    int    level;
+    int    n = 0;
+
+    if (leaf >= tree->numLeaves) return -1;
+
+    for (level = 0; level < tree->numLevels - 1; level++, index /= 2)
+    {
+        if ((index ^ 1) < tree->levelCount[level])
+        {
+            memcpy(path[n++], tree->nodes[tree->levelStart[level] + (index ^ 1)], SHA256_BLOCK_SIZE);
+        }
+    }
+    return n;
+}
+
+
+/**************************************
+ * MERKLE_Verify
+ **************************************/
+int MERKLE_Verify(const uint8_t root[SHA256_BLOCK_SIZE], size_t numLeaves, size_t leaf,
+                  const uint8_t* data, size_t len, const uint8_t path[][SHA256_BLOCK_SIZE], int pathLen)
+{
+    SHA256_CTX ctx;
+    uint8_t    digest[SHA256_BLOCK_SIZE];
+    uint8_t    pair[2 * SHA256_BLOCK_SIZE];
+    size_t     count = numLeaves;
+    size_t     index = leaf;
+    int        n = 0;
+
+    if (leaf >= numLeaves) return 0;
+
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, len);
+    sha256_final(&ctx, digest);
+
+    // Follow the leaf up, pairing it with the next path digest at each
+    // level where it has a sibling.
+    for ( ; count > 1; count = (count + 1) / 2, index /= 2)
+    {
+        if ((index ^ 1) >= count) continue;
+        if (n == pathLen) return 0;
+
+        if (index & 1)
+        {
+            memcpy(pair, path[n++], SHA256_BLOCK_SIZE);
+            memcpy(pair + SHA256_BLOCK_SIZE, digest, SHA256_BLOCK_SIZE);
+        }
+        else
+        {
+            memcpy(pair, digest, SHA256_BLOCK_SIZE);
+            memcpy(pair + SHA256_BLOCK_SIZE, path[n++], SHA256_BLOCK_SIZE);
+        }
+        sha256_64(pair, digest);
+    }
+
+    return (n == pathLen) && (memcmp(digest, root, SHA256_BLOCK_SIZE) == 0);
+}
+
+
+/******************************************************************************
+ * Private functions.
+ ******************************************************************************/
+
+/**************************************
+ * merkleLeafTask
+ **************************************/
+static void merkleLeafTask(void* arg, size_t index)
+{
+    MERKLE_JOB*    job  = (MERKLE_JOB*)arg;
+    MERKLE_TREE*   tree = job->tree;
+    const uint8_t* msgs[LEAF_GROUP];
+    size_t         lens[LEAF_GROUP];
+    size_t         first = index * job->nodesPerTask;
+    size_t         last  = first + job->nodesPerTask;
+    size_t         offset;
+    size_t         n;
+    size_t         i;
+
+    if (last > tree->numLeaves)
+    {
+        last = tree->numLeaves;
+    }
+
+    for ( ; first < last; first += n)
+    {
+        n = (last - first < LEAF_GROUP) ? last - first : LEAF_GROUP;
+        for (i = 0; i < n; i++)
+        {
+            offset  = (first + i) * tree->leafSize;
+            msgs[i] = job->data + offset;
+            lens[i] = (job->len - offset < tree->leafSize) ? job->len - offset : tree->leafSize;
+        }
+        sha256_many(msgs, lens, (int)n, &tree->nodes[first]);
+    }
+}
+
+
+/**************************************
+ * merkleParentTask
+ **************************************/
+static void merkleParentTask(void* arg, size_t index)
+{
+    MERKLE_JOB* job   = (MERKLE_JOB*)arg;
+    size_t      first = index * job->nodesPerTask;
+    size_t      last  = first + job->nodesPerTask;
+
+    if (last > job->tree->levelCount[job->level])
+    {
+        last = job->tree->levelCount[job->level];
+    }
+    merkleParents(job->tree, job->level, first, last);
+}
+
+
+/**************************************
+ * merkleParents
+ **************************************/
+static void merkleParents(MERKLE_TREE* tree, int level, size_t first, size_t last)
+{
+    size_t   numChildren = tree->levelCount[level - 1];
+    uint8_t* child       = tree->nodes[tree->levelStart[level - 1] + 2 * first];
+    uint8_t* parent      = tree->nodes[tree->levelStart[level] + first];
+
+    // Sibling digests are adjacent, so each pair is hashed in place.
+    for ( ; first < last; first++, child += 2 * SHA256_BLOCK_SIZE, parent += SHA256_BLOCK_SIZE)
+    {
+        if (2 * first + 1 < numChildren)
+        {
+            sha256_64(child, parent);
+        }
+        else
+        {
+            memcpy(parent, child, SHA256_BLOCK_SIZE);
+        }
+    }
+}
+
+
+/**************************************
+ * merkleLeaf
+ **************************************/
+static void merkleLeaf(MERKLE_TREE* tree, size_t leaf, const uint8_t* data)
+{
+    SHA256_CTX ctx;
+    size_t     offset = leaf * tree->leafSize;
+    size_t     len    = tree->len - offset;
+
+    if (len > tree->leafSize)
+    {
+        len = tree->leafSize;
+    }
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, len);
+    sha256_final(&ctx, tree->nodes[leaf]);
+}
+
+
+/**************************************
+ * merkleCompare
+ **************************************/
+static int merkleCompare(const void* a, const void* b)
+{
+    size_t x = *(const size_t*)a;
+    size_t y = *(const size_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+// End of file.
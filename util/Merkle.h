@@ -0,0 +1,258 @@
+/******************************************************************************
+ * Merkle.h
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added leaf updates: MERKLE_Update(), MERKLE_SetLeaf() and
+ * MERKLE_Commit().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * SHA-256 Merkle trees of large buffers and files, built on a thread pool.
+ *
+ * The data is cut into fixed-size leaves, the last one possibly short, and
+ * each leaf digest is the SHA-256 of its bytes.  Each parent is the
+ * SHA-256 of its two children's digests, left then right, computed with
+ * sha256_64().  When a level has an odd number of nodes the last one is
+ * carried up to the next level unchanged.  Empty data is a single empty
+ * leaf.
+ *
+ * The leaves are hashed in parallel, so a large file is fingerprinted at
+ * the speed of all the cores rather than one.  The tree keeps every level,
+ * so the proof path of any leaf can be taken from it, and a leaf can then
+ * be checked against the root on its own with MERKLE_Verify().
+ *
+ * A tree can be kept up to date as its data changes.  MERKLE_Update()
+ * rehashes one leaf and the path from it to the root.  For many changes,
+ * MERKLE_SetLeaf() rehashes each leaf and MERKLE_Commit() then rehashes
+ * every ancestor of the changed leaves once, so ancestors they share are
+ * not hashed again for each leaf.  Either way an update costs O(log n)
+ * parent hashes per leaf rather than a rebuild.
+ *
+ * The levels lie one after another in the digest array, so sibling digests
+ * are adjacent and are hashed in place as the 64-byte input of their
+ * parent, and the upper levels, which every update passes through, are
+ * packed into a few cache lines at the end of the array.
+ *
+ * Leaf and parent digests are not domain separated, so the root only
+ * identifies the data together with the leaf size and the leaf count.
+ *
+ * Intended for host builds with pthreads and mmap; see ThreadPool.h.
+ */
+
+#ifndef _MERKLE_H
+#define _MERKLE_H
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "sha256.h"
+#include "ThreadPool.h"
+
+
+/******************************************************************************
+ * Public definitions.
+ ******************************************************************************/
+
+/**
+ * @brief
+ * Most levels a tree can have, leaves and root included.  A proof path has
+ * at most one entry fewer.
+ */
+#define MERKLE_MAX_LEVELS 65
+
+/**
+ * @brief
+ * Smallest number of parents in a level for it to be hashed on the thread
+ * pool.  Smaller levels are hashed by the calling thread.
+ */
+#define MERKLE_PARALLEL_PARENTS 4096
+
+/**
+ * @brief
+ * A Merkle tree.  The digests of all the levels are held in one array, the
+ * leaves first and the root last.
+ */
+typedef struct
+{
+    size_t   len;                            //!< Size of the data
+    size_t   leafSize;                       //!< Size of every leaf but the last
+    size_t   numLeaves;                      //!< Number of leaves
+    int      numLevels;                      //!< Number of levels, leaves and root included
+    size_t   levelStart[MERKLE_MAX_LEVELS];  //!< Index in nodes of the first node of each level
+    size_t   levelCount[MERKLE_MAX_LEVELS];  //!< Number of nodes in each level
+    uint8_t  (*nodes)[SHA256_BLOCK_SIZE];    //!< The digests, level by level
+    size_t*  dirty;                          //!< Leaves set since the last commit
+    size_t   numDirty;                       //!< Number of entries in dirty
+    size_t   dirtySize;                      //!< Room in dirty
+} MERKLE_TREE;
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Builds the Merkle tree of a buffer on a thread pool.
+ *
+ * @param pool The thread pool to run on
+ *
+ * @param tree Receives the tree; release it with MERKLE_Free()
+ *
+ * @param data Pointer to the data
+ *
+ * @param len The size of the data in bytes
+ *
+ * @param leafSize The size of a leaf in bytes
+ *
+ * @return 0 on success, -1 if leafSize is 0 or memory could not be
+ * allocated.
+ */
+int MERKLE_Build(THREADPOOL* pool, MERKLE_TREE* tree, const uint8_t* data, size_t len, size_t leafSize);
+
+/**
+ * @brief
+ * Builds the Merkle tree of a file on a thread pool.
+ *
+ * The file is memory mapped read-only, so it is read straight from the
+ * page cache without copying.
+ *
+ * @param pool The thread pool to run on
+ *
+ * @param tree Receives the tree; release it with MERKLE_Free()
+ *
+ * @param path Path of the file
+ *
+ * @param leafSize The size of a leaf in bytes
+ *
+ * @return 0 on success, -1 if the file could not be opened or mapped, or
+ * as for MERKLE_Build().
+ */
+int MERKLE_BuildFile(THREADPOOL* pool, MERKLE_TREE* tree, const char* path, size_t leafSize);
+
+/**
+ * @brief
+ * Replaces the data of one leaf and rehashes the path from it to the root.
+ *
+ * @param tree Pointer to the tree
+ *
+ * @param leaf Number of the leaf, from 0
+ *
+ * @param data Pointer to the new leaf data, leafSize bytes, or as many as
+ * the last leaf holds for the last leaf
+ *
+ * @return 0 on success, -1 if there is no such leaf.
+ */
+int MERKLE_Update(MERKLE_TREE* tree, size_t leaf, const uint8_t* data);
+
+/**
+ * @brief
+ * Replaces the data of one leaf and rehashes the leaf, leaving its
+ * ancestors for MERKLE_Commit().  Until then the root and the proof paths
+ * are out of date.
+ *
+ * @param tree Pointer to the tree
+ *
+ * @param leaf Number of the leaf, from 0
+ *
+ * @param data Pointer to the new leaf data, as for MERKLE_Update()
+ *
+ * @return 0 on success, -1 if there is no such leaf or memory could not be
+ * allocated.
+ */
+int MERKLE_SetLeaf(MERKLE_TREE* tree, size_t leaf, const uint8_t* data);
+
+/**
+ * @brief
+ * Rehashes the ancestors of the leaves set with MERKLE_SetLeaf(), each
+ * once, level by level.
+ *
+ * @param tree Pointer to the tree
+ */
+void MERKLE_Commit(MERKLE_TREE* tree);
+
+/**
+ * @brief
+ * Releases the digests held by a tree.
+ *
+ * @param tree Pointer to the tree
+ */
+void MERKLE_Free(MERKLE_TREE* tree);
+
+/**
+ * @brief
+ * Returns the root digest of a tree.
+ *
+ * @param tree Pointer to the tree
+ *
+ * @return Pointer to the SHA256_BLOCK_SIZE byte root digest.
+ */
+const uint8_t* MERKLE_Root(const MERKLE_TREE* tree);
+
+/**
+ * @brief
+ * Gets the proof path of a leaf: the digest of the sibling at each level,
+ * from the leaves up, skipping the levels where the node has no sibling.
+ *
+ * @param tree Pointer to the tree
+ *
+ * @param leaf Number of the leaf, from 0
+ *
+ * @param path Receives the digests; room for (MERKLE_MAX_LEVELS - 1) is
+ * always enough
+ *
+ * @return The number of digests in the path, or -1 if there is no such
+ * leaf.
+ */
+int MERKLE_Proof(const MERKLE_TREE* tree, size_t leaf, uint8_t path[][SHA256_BLOCK_SIZE]);
+
+/**
+ * @brief
+ * Checks one leaf of data against a root digest and the leaf's proof path.
+ *
+ * @param root The root digest
+ *
+ * @param numLeaves The number of leaves in the tree
+ *
+ * @param leaf Number of the leaf, from 0
+ *
+ * @param data Pointer to the leaf data
+ *
+ * @param len The size of the leaf data in bytes
+ *
+ * @param path The proof path from MERKLE_Proof()
+ *
+ * @param pathLen The number of digests in the path
+ *
+ * @return 1 if the leaf and path hash to the root, 0 if not.
+ */
+int MERKLE_Verify(const uint8_t root[SHA256_BLOCK_SIZE], size_t numLeaves, size_t leaf,
+                  const uint8_t* data, size_t len, const uint8_t path[][SHA256_BLOCK_SIZE], int pathLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _MERKLE_H
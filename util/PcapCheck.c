@@ -0,0 +1,657 @@
+/******************************************************************************
+ * PcapCheck.c
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Multi-threaded verification of the checksums of the packets in a pcap or
+ * pcapng capture.
+ *
+ * Records are variable length, so finding them is sequential.  The calling
+ * thread walks a batch of record headers into an index, touching little
+ * more than the headers, and the pool then verifies the batch's packets,
+ * which is where the bytes are read.
+ */
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "PcapCheck.h"
+#include "Checksum.h"
+
+
+/******************************************************************************
+ * Local definitions.
+ ******************************************************************************/
+
+/**
+ * @brief
+ * Number of tasks per thread in each batch, so that threads finishing early
+ * can pick up more work.
+ */
+#define TASKS_PER_THREAD 4
+
+/**
+ * @brief
+ * Most pcapng interfaces per section whose link types are kept.  Packets on
+ * later interfaces are skipped.
+ */
+#define PCAPCHECK_MAX_INTERFACES 64
+
+/** @name Link types (https://www.tcpdump.org/linktypes.html) */
+/** @{ */
+#define LINKTYPE_ETHERNET   1
+#define LINKTYPE_RAW        101
+#define LINKTYPE_LINUX_SLL  113
+#define LINKTYPE_IPV4       228
+#define LINKTYPE_IPV6       229
+#define LINKTYPE_LINUX_SLL2 276
+#define LINKTYPE_UNKNOWN    0xFFFF
+/** @} */
+
+/** @name pcapng block types */
+/** @{ */
+#define PCAPNG_SHB 0x0A0D0D0Au  //!< Section header
+#define PCAPNG_IDB 0x00000001u  //!< Interface description
+#define PCAPNG_OPB 0x00000002u  //!< Packet (obsolete)
+#define PCAPNG_SPB 0x00000003u  //!< Simple packet
+#define PCAPNG_EPB 0x00000006u  //!< Enhanced packet
+/** @} */
+
+/**
+ * @brief
+ * One packet record found by the walker.
+ */
+typedef struct
+{
+    uint64_t offset;    //!< Offset of the packet data in the capture
+    uint32_t length;    //!< Captured length of the packet
+    uint16_t linkType;  //!< Link type of the packet
+    uint8_t  flags;     //!< PCAPCHECK_BAD_ flags, set by the verifier
+} PCAPCHECK_RECORD;
+
+/**
+ * @brief
+ * State of the walk through a capture.
+ */
+typedef struct
+{
+    const uint8_t* data;      //!< Start of the capture
+    size_t         len;       //!< Size of the capture
+    size_t         pos;       //!< Offset of the next record or block
+    int            pcapng;    //!< Non-zero for pcapng
+    int            swap;      //!< Non-zero if the file's byte order is not the host's
+    uint16_t       linkType;  //!< pcap link type
+    uint32_t       numLinks;  //!< pcapng interfaces in the current section
+    uint16_t       links[PCAPCHECK_MAX_INTERFACES];  //!< pcapng link types
+} PCAPCHECK_WALKER;
+
+/**
+ * @brief
+ * One batch of records being verified.
+ */
+typedef struct
+{
+    const uint8_t*    data;       //!< Start of the capture
+    PCAPCHECK_RECORD* records;    //!< Records of the batch
+    size_t            numRecords; //!< Number of records in the batch
+    size_t            perTask;    //!< Records per task
+    PCAPCHECK_STATS*  taskStats;  //!< Counts of each task
+} PCAPCHECK_JOB;
+
+
+/******************************************************************************
+ * Forward references.
+ ******************************************************************************/
+static int      pcapCheckOpen(PCAPCHECK_WALKER* walker, const uint8_t* data, size_t len);
+static int      pcapCheckNext(PCAPCHECK_WALKER* walker, PCAPCHECK_RECORD* record, PCAPCHECK_STATS* stats);
+static int      pcapCheckNextBlock(PCAPCHECK_WALKER* walker, PCAPCHECK_RECORD* record, PCAPCHECK_STATS* stats);
+static void     pcapCheckTask(void* arg, size_t index);
+static int      pcapCheckPacket(const uint8_t* pkt, size_t len, uint16_t linkType, PCAPCHECK_STATS* stats);
+static int      pcapCheckIpv4(const uint8_t* pkt, size_t len, PCAPCHECK_STATS* stats);
+static int      pcapCheckIpv6(const uint8_t* pkt, size_t len, PCAPCHECK_STATS* stats);
+static int      pcapCheckL4(uint8_t proto, const uint8_t* src, const uint8_t* dst, int ipv6,
+                            const uint8_t* seg, size_t len, PCAPCHECK_STATS* stats);
+static uint32_t pcapCheckRead32(const PCAPCHECK_WALKER* walker, size_t offset);
+static uint16_t pcapCheckRead16(const PCAPCHECK_WALKER* walker, size_t offset);
+static uint16_t pcapCheckBe16(const uint8_t* ptr);
+
+
+/******************************************************************************
+ * Local data.
+ ******************************************************************************/
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+/**************************************
+ * PCAPCHECK_Buffer
+ **************************************/
+int PCAPCHECK_Buffer(THREADPOOL* pool, const uint8_t* data, size_t len,
+                     PCAPCHECK_STATS* stats, PCAPCHECK_REPORT report, void* arg)
+{
+    PCAPCHECK_WALKER walker;
+    PCAPCHECK_JOB    job;
+    size_t           numTasks = (size_t)THREADPOOL_Size(pool) * TASKS_PER_THREAD;
+    size_t           i;
+    size_t           t;
+    int              result = 1;
+
+    memset(stats, 0, sizeof(*stats));
+    if (pcapCheckOpen(&walker, data, len) != 0) return -1;
+
+    job.data      = data;
+    job.records   = (PCAPCHECK_RECORD*)malloc(PCAPCHECK_BATCH * sizeof(PCAPCHECK_RECORD));
+    job.taskStats = (PCAPCHECK_STATS*)malloc(numTasks * sizeof(PCAPCHECK_STATS));
+    if ((job.records == NULL) || (job.taskStats == NULL))
+    {
+        free(job.records);
+        free(job.taskStats);
+        return -1;
+    }
+
+    while (result > 0)
+    {
+        // Walk the next batch of records.
+        job.numRecords = 0;
+        while ((job.numRecords < PCAPCHECK_BATCH) &&
+               ((result = pcapCheckNext(&walker, &job.records[job.numRecords], stats)) > 0))
+        {
+            job.numRecords++;
+        }
+        if (job.numRecords == 0) break;
+
+        // Verify it.
+        job.perTask = (job.numRecords + numTasks - 1) / numTasks;
+        t = (job.numRecords + job.perTask - 1) / job.perTask;
+        THREADPOOL_Run(pool, pcapCheckTask, &job, t);
+
+        while (t-- > 0)
+        {
+            stats->ipv4    += job.taskStats[t].ipv4;
+            stats->ipv4Bad += job.taskStats[t].ipv4Bad;
+            stats->tcp     += job.taskStats[t].tcp;
+            stats->tcpBad  += job.taskStats[t].tcpBad;
+            stats->udp     += job.taskStats[t].udp;
+            stats->udpBad  += job.taskStats[t].udpBad;
+            stats->skipped += job.taskStats[t].skipped;
+        }
+
+        // Report in capture order.
+        if (report != NULL)
+        {
+            for (i = 0; i < job.numRecords; i++)
+            {
+                if (job.records[i].flags != 0)
+                {
+                    report(arg, stats->packets + i, job.records[i].offset, job.records[i].flags);
+                }
+            }
+        }
+        stats->packets += job.numRecords;
+    }
+
+    free(job.records);
+    free(job.taskStats);
+    return (result < 0) ? -1 : 0;
+}
+
+
+/**************************************
+ * PCAPCHECK_File
+ **************************************/
+int PCAPCHECK_File(THREADPOOL* pool, const char* path,
+                   PCAPCHECK_STATS* stats, PCAPCHECK_REPORT report, void* arg)
+{
+    struct stat st;
+    void*       map;
+    int         fd;
+    int         result;
+
+    memset(stats, 0, sizeof(*stats));
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    if ((fstat(fd, &st) != 0) || (st.st_size <= 0))
+    {
+        close(fd);
+        return -1;
+    }
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+    result = PCAPCHECK_Buffer(pool, (const uint8_t*)map, (size_t)st.st_size, stats, report, arg);
+
+    munmap(map, (size_t)st.st_size);
+    return result;
+}
+
+
+/******************************************************************************
+ * Private functions.
+ ******************************************************************************/
+
+/**************************************
+ * pcapCheckOpen
+ **************************************/
+static int pcapCheckOpen(PCAPCHECK_WALKER* walker, const uint8_t* data, size_t len)
+{
+    uint32_t magic;
+
+    memset(walker, 0, sizeof(*walker));
+    walker->data = data;
+    walker->len  = len;
+    if (len < 24) return -1;
+
+    memcpy(&magic, data, 4);
+    switch (magic)
+    {
+        case 0xA1B2C3D4u:  // Microseconds
+        case 0xA1B23C4Du:  // Nanoseconds
+            break;
+
+        case 0xD4C3B2A1u:
+        case 0x4D3CB2A1u:
+            walker->swap = 1;
+            break;
+
+        case PCAPNG_SHB:
+            // The section header sets the byte order; see pcapCheckNextBlock().
+            walker->pcapng = 1;
+            return 0;
+
+        default:
+            return -1;
+    }
+
+    // The upper bits of the link type field carry FCS information.
+    walker->linkType = (uint16_t)pcapCheckRead32(walker, 20);
+    walker->pos      = 24;
+    return 0;
+}
+
+
+/**************************************
+ * pcapCheckNext
+ **************************************/
+static int pcapCheckNext(PCAPCHECK_WALKER* walker, PCAPCHECK_RECORD* record, PCAPCHECK_STATS* stats)
+{
+    size_t   left = walker->len - walker->pos;
+    uint32_t capLen;
+
+    if (walker->pcapng)
+    {
+        return pcapCheckNextBlock(walker, record, stats);
+    }
+
+    if (left == 0) return 0;
+    if (left < 16)
+    {
+        stats->truncated = 1;
+        return 0;
+    }
+
+    capLen = pcapCheckRead32(walker, walker->pos + 8);
+    if (capLen > left - 16)
+    {
+        stats->truncated = 1;
+        return 0;
+    }
+
+    record->offset   = walker->pos + 16;
+    record->length   = capLen;
+    record->linkType = walker->linkType;
+    record->flags    = 0;
+    walker->pos     += 16 + (size_t)capLen;
+    stats->bytes    += capLen;
+    return 1;
+}
+
+
+/**************************************
+ * pcapCheckNextBlock
+ **************************************/
+static int pcapCheckNextBlock(PCAPCHECK_WALKER* walker, PCAPCHECK_RECORD* record, PCAPCHECK_STATS* stats)
+{
+    size_t   left;
+    size_t   pos;
+    uint32_t type;
+    uint32_t blockLen;
+    uint32_t bom;
+    uint32_t iface;
+    uint32_t capLen;
+    size_t   dataPos;
+
+    for (;;)
+    {
+        pos  = walker->pos;
+        left = walker->len - pos;
+        if (left == 0) return 0;
+        if (left < 12)
+        {
+            stats->truncated = 1;
+            return 0;
+        }
+
+        memcpy(&type, walker->data + pos, 4);
+        if (type == PCAPNG_SHB)
+        {
+            // The byte-order magic decides how the rest of the section,
+            // including this block's length, is read.
+            memcpy(&bom, walker->data + pos + 8, 4);
+            if (bom == 0x1A2B3C4Du)      walker->swap = 0;
+            else if (bom == 0x4D3C2B1Au) walker->swap = 1;
+            else return -1;
+            walker->numLinks = 0;
+        }
+        else
+        {
+            type = pcapCheckRead32(walker, pos);
+        }
+
+        blockLen = pcapCheckRead32(walker, pos + 4);
+        if ((blockLen < 12) || (blockLen & 3)) return -1;
+        if (blockLen > left)
+        {
+            stats->truncated = 1;
+            return 0;
+        }
+        walker->pos += blockLen;
+
+        switch (type)
+        {
+            case PCAPNG_IDB:
+                if (blockLen < 20) return -1;
+                if (walker->numLinks < PCAPCHECK_MAX_INTERFACES)
+                {
+                    walker->links[walker->numLinks] = pcapCheckRead16(walker, pos + 8);
+                }
+                walker->numLinks++;
+                continue;
+
+            case PCAPNG_EPB:
+            case PCAPNG_OPB:
+                if (blockLen < 32) return -1;
+                iface   = (type == PCAPNG_EPB) ? pcapCheckRead32(walker, pos + 8)
+                                               : pcapCheckRead16(walker, pos + 8);
+                capLen  = pcapCheckRead32(walker, pos + 20);
+                dataPos = 28;
+                if (capLen > blockLen - 32) return -1;
+                break;
+
+            case PCAPNG_SPB:
+                if (blockLen < 16) return -1;
+                iface   = 0;
+                capLen  = pcapCheckRead32(walker, pos + 8);
+                dataPos = 12;
+                if (capLen > blockLen - 16)
+                {
+                    // Cut to the snapshot length; the rest is padding.
+                    capLen = blockLen - 16;
+                }
+                break;
+
+            default:
+                continue;
+        }
+
+        record->offset   = pos + dataPos;
+        record->length   = capLen;
+        record->linkType = ((iface < walker->numLinks) && (iface < PCAPCHECK_MAX_INTERFACES))
+                         ? walker->links[iface] : LINKTYPE_UNKNOWN;
+        record->flags    = 0;
+        stats->bytes    += capLen;
+        return 1;
+    }
+}
+
+
+/**************************************
+ * pcapCheckTask
+ **************************************/
+static void pcapCheckTask(void* arg, size_t index)
+{
+    PCAPCHECK_JOB*    job   = (PCAPCHECK_JOB*)arg;
+    size_t            first = index * job->perTask;
+    size_t            last  = first + job->perTask;
+    PCAPCHECK_STATS   stats;
+    PCAPCHECK_RECORD* record;
+    int               flags;
+
+    if (last > job->numRecords)
+    {
+        last = job->numRecords;
+    }
+
+    // Count locally so that tasks do not share cache lines.
+    memset(&stats, 0, sizeof(stats));
+    for (; first < last; first++)
+    {
+        record = &job->records[first];
+        flags  = pcapCheckPacket(job->data + record->offset, record->length, record->linkType, &stats);
+        if (flags < 0)
+        {
+            stats.skipped++;
+            flags = 0;
+        }
+        record->flags = (uint8_t)flags;
+    }
+    job->taskStats[index] = stats;
+}
+
+
+/**************************************
+ * pcapCheckPacket
+ **************************************/
+static int pcapCheckPacket(const uint8_t* pkt, size_t len, uint16_t linkType, PCAPCHECK_STATS* stats)
+{
+    uint16_t etherType;
+    size_t   hdrLen;
+
+    switch (linkType)
+    {
+        case LINKTYPE_ETHERNET:
+            if (len < 14) return -1;
+            etherType = pcapCheckBe16(pkt + 12);
+            hdrLen    = 14;
+            // 802.1Q and 802.1ad tags.
+            while (((etherType == 0x8100) || (etherType == 0x88A8)) && (len >= hdrLen + 4))
+            {
+                etherType = pcapCheckBe16(pkt + hdrLen + 2);
+                hdrLen   += 4;
+            }
+            break;
+
+        case LINKTYPE_LINUX_SLL:
+            if (len < 16) return -1;
+            etherType = pcapCheckBe16(pkt + 14);
+            hdrLen    = 16;
+            break;
+
+        case LINKTYPE_LINUX_SLL2:
+            if (len < 20) return -1;
+            etherType = pcapCheckBe16(pkt);
+            hdrLen    = 20;
+            break;
+
+        case LINKTYPE_RAW:
+        case LINKTYPE_IPV4:
+        case LINKTYPE_IPV6:
+            if (len < 1) return -1;
+            etherType = ((pkt[0] >> 4) == 6) ? 0x86DD : 0x0800;
+            hdrLen    = 0;
+            break;
+
+        default:
+            return -1;
+    }
+
+    if (etherType == 0x0800) return pcapCheckIpv4(pkt + hdrLen, len - hdrLen, stats);
+    if (etherType == 0x86DD) return pcapCheckIpv6(pkt + hdrLen, len - hdrLen, stats);
+    return -1;
+}
+
+
+/**************************************
+ * pcapCheckIpv4
+ **************************************/
+static int pcapCheckIpv4(const uint8_t* pkt, size_t len, PCAPCHECK_STATS* stats)
+{
+    size_t hdrLen;
+    size_t totalLen;
+    int    flags = 0;
+    int    l4;
+
+    if ((len < 20) || ((pkt[0] >> 4) != 4)) return -1;
+    hdrLen = (size_t)(pkt[0] & 0x0F) * 4;
+    if ((hdrLen < 20) || (hdrLen > len)) return -1;
+
+    stats->ipv4++;
+    if (ipv4_checksum(pkt, hdrLen) != 0)
+    {
+        stats->ipv4Bad++;
+        flags |= PCAPCHECK_BAD_IPV4;
+    }
+
+    // Ethernet may pad the frame past the total length.  Fragments and
+    // packets cut short by the snapshot length cannot be verified.
+    totalLen = pcapCheckBe16(pkt + 2);
+    if ((totalLen < hdrLen) || (totalLen > len)) return flags;
+    if (pcapCheckBe16(pkt + 6) & 0x3FFF) return flags;
+
+    l4 = pcapCheckL4(pkt[9], pkt + 12, pkt + 16, 0, pkt + hdrLen, totalLen - hdrLen, stats);
+    return (l4 > 0) ? (flags | l4) : flags;
+}
+
+
+/**************************************
+ * pcapCheckIpv6
+ **************************************/
+static int pcapCheckIpv6(const uint8_t* pkt, size_t len, PCAPCHECK_STATS* stats)
+{
+    size_t  end;
+    size_t  pos = 40;
+    uint8_t next;
+
+    if ((len < 40) || ((pkt[0] >> 4) != 6)) return -1;
+    end = 40 + (size_t)pcapCheckBe16(pkt + 4);
+    if (end > len) return -1;
+
+    // Skip the hop-by-hop, routing and destination options headers.
+    next = pkt[6];
+    while ((next == 0) || (next == 43) || (next == 60))
+    {
+        if (pos + 8 > end) return -1;
+        next = pkt[pos];
+        pos += ((size_t)pkt[pos + 1] + 1) * 8;
+    }
+    if (pos > end) return -1;
+
+    return pcapCheckL4(next, pkt + 8, pkt + 24, 1, pkt + pos, end - pos, stats);
+}
+
+
+/**************************************
+ * pcapCheckL4
+ **************************************/
+static int pcapCheckL4(uint8_t proto, const uint8_t* src, const uint8_t* dst, int ipv6,
+                       const uint8_t* seg, size_t len, PCAPCHECK_STATS* stats)
+{
+    struct iovec iov;
+    uint16_t     sum;
+
+    iov.iov_base = (void*)seg;
+    iov.iov_len  = len;
+
+    if ((proto == 6) && (len >= 20))
+    {
+        sum = ipv6 ? l4_checksum_v6(src, dst, proto, &iov, 1) : l4_checksum_v4(src, dst, proto, &iov, 1);
+        stats->tcp++;
+        if (sum == 0) return 0;
+        stats->tcpBad++;
+        return PCAPCHECK_BAD_TCP;
+    }
+
+    if ((proto == 17) && (len >= 8))
+    {
+        // Zero means no checksum over IPv4; over IPv6 it is an error.
+        if (!ipv6 && (seg[6] == 0) && (seg[7] == 0)) return -1;
+        sum = ipv6 ? l4_checksum_v6(src, dst, proto, &iov, 1) : l4_checksum_v4(src, dst, proto, &iov, 1);
+        stats->udp++;
+        if (sum == 0) return 0;
+        stats->udpBad++;
+        return PCAPCHECK_BAD_UDP;
+    }
+
+    return -1;
+}
+
+
+/**************************************
+ * pcapCheckRead32
+ **************************************/
+static uint32_t pcapCheckRead32(const PCAPCHECK_WALKER* walker, size_t offset)
+{
+    uint32_t value;
+
+    memcpy(&value, walker->data + offset, 4);
+    if (walker->swap)
+    {
+        value = (value >> 24) | ((value >> 8) & 0xFF00u) | ((value << 8) & 0xFF0000u) | (value << 24);
+    }
+    return value;
+}
+
+
+/**************************************
+ * pcapCheckRead16
+ **************************************/
+static uint16_t pcapCheckRead16(const PCAPCHECK_WALKER* walker, size_t offset)
+{
+    uint16_t value;
+
+    memcpy(&value, walker->data + offset, 2);
+    if (walker->swap)
+    {
+        value = (uint16_t)((value >> 8) | (value << 8));
+    }
+    return value;
+}
+
+
+/**************************************
+ * pcapCheckBe16
+ **************************************/
+static uint16_t pcapCheckBe16(const uint8_t* ptr)
+{
+    return (uint16_t)((ptr[0] << 8) | ptr[1]);
+}
+
+// End of file.
@@ -0,0 +1,162 @@
+/******************************************************************************
+ * PcapCheck.h
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * Multi-threaded verification of the IPv4 header, TCP and UDP checksums of
+ * the packets in a pcap or pcapng capture.
+ *
+ * The capture is walked record by record in place, a batch of records at a
+ * time, and each batch is verified on a thread pool with the kernels in
+ * Checksum.c.  Mismatches are reported in capture order.
+ *
+ * Both byte orders and the microsecond and nanosecond variants of pcap are
+ * read, as are the enhanced, simple and obsolete packet blocks of pcapng.
+ * Packets must be Ethernet (with any number of 802.1Q tags), Linux cooked
+ * (SLL), or raw IPv4/IPv6 frames.  A packet is skipped, not reported, when
+ * its link type is not one of these or it is not IPv4 or IPv6, it was cut
+ * short by the snapshot length, or it is a fragment.
+ *
+ * Captures taken on a sending host usually hold outgoing packets whose TCP
+ * and UDP checksums were left for the network card to fill in, so they
+ * show as mismatches.
+ *
+ * Intended for host builds with pthreads and mmap; see ThreadPool.h.
+ */
+
+#ifndef _PCAP_CHECK_H
+#define _PCAP_CHECK_H
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "ThreadPool.h"
+
+
+/******************************************************************************
+ * Public definitions.
+ ******************************************************************************/
+
+/**
+ * @brief
+ * Flags passed to the report function for a packet with bad checksums.
+ */
+#define PCAPCHECK_BAD_IPV4 0x01  //!< The IPv4 header checksum is wrong
+#define PCAPCHECK_BAD_TCP  0x02  //!< The TCP checksum is wrong
+#define PCAPCHECK_BAD_UDP  0x04  //!< The UDP checksum is wrong
+
+/**
+ * @brief
+ * Number of records walked and verified per thread pool run.
+ */
+#define PCAPCHECK_BATCH 65536
+
+/**
+ * @brief
+ * Counts of what was verified in a capture.
+ */
+typedef struct
+{
+    uint64_t packets;    //!< Packet records read
+    uint64_t bytes;      //!< Captured packet bytes read
+    uint64_t ipv4;       //!< IPv4 headers verified
+    uint64_t ipv4Bad;    //!< IPv4 headers with a wrong checksum
+    uint64_t tcp;        //!< TCP segments verified
+    uint64_t tcpBad;     //!< TCP segments with a wrong checksum
+    uint64_t udp;        //!< UDP datagrams verified
+    uint64_t udpBad;     //!< UDP datagrams with a wrong checksum
+    uint64_t skipped;    //!< Packets with nothing that could be verified
+    int      truncated;  //!< Non-zero if the capture ends in a partial record
+} PCAPCHECK_STATS;
+
+/**
+ * @brief
+ * Called once for each packet with a bad checksum, in capture order.
+ *
+ * @param arg The argument passed to PCAPCHECK_Buffer() or PCAPCHECK_File()
+ *
+ * @param packet Number of the packet record in the capture, from 0
+ *
+ * @param offset Offset of the packet data in the capture
+ *
+ * @param flags The PCAPCHECK_BAD_ flags of the checksums that are wrong
+ */
+typedef void (*PCAPCHECK_REPORT)(void* arg, uint64_t packet, uint64_t offset, int flags);
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Verifies the checksums of the packets in a capture held in memory.
+ *
+ * @param pool The thread pool to run on
+ *
+ * @param data Pointer to the capture
+ *
+ * @param len The size of the capture in bytes
+ *
+ * @param stats Receives the counts
+ *
+ * @param report Called for each packet with a bad checksum, or NULL
+ *
+ * @param arg Argument passed to the report function
+ *
+ * @return 0 on success, -1 if the data is not a pcap or pcapng capture or
+ * a record is malformed.  The counts cover the records before the error.
+ */
+int PCAPCHECK_Buffer(THREADPOOL* pool, const uint8_t* data, size_t len,
+                     PCAPCHECK_STATS* stats, PCAPCHECK_REPORT report, void* arg);
+
+/**
+ * @brief
+ * Verifies the checksums of the packets in a capture file.
+ *
+ * The file is memory mapped read-only, so it is read straight from the
+ * page cache without copying.
+ *
+ * @param pool The thread pool to run on
+ *
+ * @param path Path of the file
+ *
+ * @param stats Receives the counts
+ *
+ * @param report Called for each packet with a bad checksum, or NULL
+ *
+ * @param arg Argument passed to the report function
+ *
+ * @return 0 on success, -1 if the file could not be opened or mapped, or
+ * as for PCAPCHECK_Buffer().
+ */
+int PCAPCHECK_File(THREADPOOL* pool, const char* path,
+                   PCAPCHECK_STATS* stats, PCAPCHECK_REPORT report, void* arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PCAP_CHECK_H
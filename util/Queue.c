@@ -7,6 +7,9 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added QUEUE_EnqueueBlock(), if USE_QUEUE_CRC is defined.
+ *
  * 09/15/2015 - Tom Kerr
  * Created.
  ******************************************************************************/
@@ -27,6 +30,8 @@
  * not disable interrupts or use mutexes for thread safe access.
  *
  * QUEUE_Enqueue(), QUEUE_Dequeue(), and QUEUE_Peek() copy data to/from the queue.
+ * QUEUE_EnqueueBlock() copies an array of data elements into the queue, and
+ * can add them to a running CRC on the way in, if USE_QUEUE_CRC is defined.
  *
  * QUEUE_EnqueuePtr(), QUEUE_DequeuePtr(), and QUEUE_PeekPtr() return pointers
  * to queued data elements were data can be copied or manipulated directly.
@@ -55,6 +60,15 @@
  */
 static void QUEUE_Copy(char* dst, const char* src, size_t len);
 
+#if defined(USE_QUEUE_CRC)
+/**
+ * @brief
+ * Copy function that also updates a running CRC if one is given, and
+ * accepts a zero length.
+ */
+static void QUEUE_CopyCrc(char* dst, const char* src, size_t len, CRC_CTX* ctx);
+#endif
+
 
 /******************************************************************************
  * Local definitions.
@@ -167,6 +181,63 @@ int QUEUE_Enqueue(QUEUE* queue, const void* pData)
 }
 
 
+#if defined(USE_QUEUE_CRC)
+/**************************************
+ * QUEUE_EnqueueBlock
+ **************************************/
+int QUEUE_EnqueueBlock(QUEUE* queue, const void* pData, int num, CRC_CTX* ctx)
+{
+    const char* src = (const char*)pData;
+    int added;
+    int drop;
+    int run;
+    
+    if (num <= 0) return 0;
+    added = num;
+    
+    if (queue->overwrite)
+    {
+        // Elements that later ones in the block would overwrite are never
+        // stored, but they were enqueued, so they still count toward the CRC.
+        if (num > queue->num)
+        {
+            drop = num - queue->num;
+            if (ctx != NULL) crc_update(ctx, (const uint8_t*)src, (size_t)drop * queue->size);
+            src += (size_t)drop * queue->size;
+            num = queue->num;
+        }
+        
+        // Dequeue oldest data elements to make room.
+        drop = num - QUEUE_Available(queue);
+        if (drop > 0)
+        {
+            queue->head += (size_t)drop * queue->size;
+            if (queue->head >= queue->end) queue->head -= (queue->end - queue->base);
+            queue->count -= drop;
+        }
+    }
+    else if (num > QUEUE_Available(queue))
+    {
+        num = QUEUE_Available(queue);
+        added = num;
+    }
+    
+    // Add data elements to tail, up to the end of queue memory and then
+    // from the base.
+    run = (int)((queue->end - queue->tail) / queue->size);
+    if (run > num) run = num;
+    QUEUE_CopyCrc(queue->tail, src, (size_t)run * queue->size, ctx);
+    queue->tail += (size_t)run * queue->size;
+    if (queue->tail >= queue->end) queue->tail = queue->base;
+    QUEUE_CopyCrc(queue->tail, src + (size_t)run * queue->size, (size_t)(num - run) * queue->size, ctx);
+    queue->tail += (size_t)(num - run) * queue->size;
+    queue->count += num;
+    
+    return added;
+}
+#endif
+
+
 /**************************************
  * QUEUE_Peek
  **************************************/
@@ -266,4 +337,22 @@ static void QUEUE_Copy(char* dst, const char* src, size_t len)
     do {*dst++ = *src++;} while(--len);
 }
 
+
+#if defined(USE_QUEUE_CRC)
+/**************************************
+ * QUEUE_CopyCrc
+ **************************************/ 
+static void QUEUE_CopyCrc(char* dst, const char* src, size_t len, CRC_CTX* ctx)
+{
+    if (ctx != NULL)
+    {
+        crc_copy((uint8_t*)dst, (const uint8_t*)src, len, ctx);
+    }
+    else if (len > 0)
+    {
+        QUEUE_Copy(dst, src, len);
+    }
+}
+#endif
+
 // End of file.
@@ -7,6 +7,9 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added QUEUE_EnqueueBlock(), if USE_QUEUE_CRC is defined.
+ *
  * 09/15/2015 - Tom Kerr
  * Created.
  ******************************************************************************/
@@ -27,6 +30,8 @@
  * not disable interrupts or use mutexes for thread safe access.
  *
  * QUEUE_Enqueue(), QUEUE_Dequeue(), and QUEUE_Peek() copy data to/from the queue.
+ * QUEUE_EnqueueBlock() copies an array of data elements into the queue, and
+ * can add them to a running CRC on the way in, if USE_QUEUE_CRC is defined.
  *
  * QUEUE_EnqueuePtr(), QUEUE_DequeuePtr(), and QUEUE_PeekPtr() return pointers
  * to queued data elements were data can be copied or manipulated directly.
@@ -53,6 +58,17 @@
  * Public definitions.
  ******************************************************************************/
 
+/*
+ * If USE_QUEUE_CRC is defined, QUEUE_EnqueueBlock() is available and can
+ * update a running CRC (see crc.h).  The program must then also link crc.c.
+ * Off by default so that the queue does not depend on the CRC module.
+ */
+//#define USE_QUEUE_CRC
+
+#if defined(USE_QUEUE_CRC)
+#include "crc.h"
+#endif
+
 /**
  * @brief
  * The queue structure that defines a specific queue. 
@@ -173,6 +189,31 @@ int QUEUE_DequeuePtr(QUEUE* queue);
  */
 int QUEUE_Enqueue(QUEUE* queue, const void* pData);
 
+/**
+ * @brief
+ * Add an array of data elements to the queue.
+ *
+ * Equivalent to calling QUEUE_Enqueue() for each element in turn, but the
+ * data is copied in at most two runs.  If ctx is not NULL, the bytes of the
+ * enqueued elements are also added to the running CRC in the same pass over
+ * the source (see crc_copy()), which requires crcInit() and a context
+ * started with crc_init().  Only built if USE_QUEUE_CRC is defined.
+ *
+ * @param queue Pointer to the queue
+ *
+ * @param pData Pointer to the first data element to add.
+ *
+ * @param num The number of data elements to add.
+ *
+ * @param ctx Running CRC of the enqueued data, or NULL.
+ *
+ * @return The number of data elements enqueued.  Less than num if the queue
+ * fills up and overwriting is disabled.
+ */
+#if defined(USE_QUEUE_CRC)
+int QUEUE_EnqueueBlock(QUEUE* queue, const void* pData, int num, CRC_CTX* ctx);
+#endif
+
 /**
  * @brief
  * Allocate a data element in the queue and return a pointer to it.
@@ -0,0 +1,224 @@
+/******************************************************************************
+ * ThreadPool.c
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * The ThreadPool module runs a set of independent tasks on a fixed pool of
+ * POSIX threads.
+ *
+ * Tasks are handed out one index at a time under the pool mutex, so they
+ * should be coarse (a chunk of a buffer, a block of records), not a few
+ * instructions each.
+ */
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stdlib.h>
+#include <unistd.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+#include "ThreadPool.h"
+
+
+/******************************************************************************
+ * Forward references.
+ ******************************************************************************/
+static void* THREADPOOL_Worker(void* arg);
+static void  THREADPOOL_Drain(THREADPOOL* pool);
+
+
+/******************************************************************************
+ * Local definitions.
+ ******************************************************************************/
+
+
+/******************************************************************************
+ * Local data.
+ ******************************************************************************/
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+/**************************************
+ * THREADPOOL_Create
+ **************************************/
+int THREADPOOL_Create(THREADPOOL* pool, int numThreads)
+{
+    int i;
+
+    if (numThreads <= 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        numThreads = (cpus > 0) ? (int)cpus : 1;
+    }
+
+    pool->numThreads = numThreads;
+    pool->task       = NULL;
+    pool->arg        = NULL;
+    pool->numTasks   = 0;
+    pool->nextTask   = 0;
+    pool->pending    = 0;
+    pool->shutdown   = 0;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    // The caller of THREADPOOL_Run() is the last thread.
+    pool->threads = NULL;
+    if (numThreads > 1)
+    {
+        pool->threads = (pthread_t*)malloc((numThreads - 1) * sizeof(pthread_t));
+        if (pool->threads == NULL)
+        {
+            pool->numThreads = 1;
+            THREADPOOL_Destroy(pool);
+            return -1;
+        }
+    }
+
+    for (i = 0; i < numThreads - 1; i++)
+    {
+        if (pthread_create(&pool->threads[i], NULL, THREADPOOL_Worker, pool) != 0)
+        {
+            pool->numThreads = i + 1;
+            THREADPOOL_Destroy(pool);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+/**************************************
+ * THREADPOOL_Destroy
+ **************************************/
+void THREADPOOL_Destroy(THREADPOOL* pool)
+{
+    int i;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < pool->numThreads - 1; i++)
+    {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    free(pool->threads);
+    pool->threads    = NULL;
+    pool->numThreads = 0;
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+
+/**************************************
+ * THREADPOOL_Size
+ **************************************/
+int THREADPOOL_Size(const THREADPOOL* pool)
+{
+    return pool->numThreads;
+}
+
+
+/**************************************
+ * THREADPOOL_Run
+ **************************************/
+void THREADPOOL_Run(THREADPOOL* pool, THREADPOOL_TASK task, void* arg, size_t numTasks)
+{
+    if (numTasks == 0) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->task     = task;
+    pool->arg      = arg;
+    pool->numTasks = numTasks;
+    pool->nextTask = 0;
+    pool->pending  = numTasks;
+    pthread_cond_broadcast(&pool->start);
+
+    // Help out, then wait for the stragglers.
+    THREADPOOL_Drain(pool);
+    while (pool->pending > 0)
+    {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pool->task = NULL;
+    pool->arg  = NULL;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+
+/******************************************************************************
+ * Private functions.
+ ******************************************************************************/
+
+/**************************************
+ * THREADPOOL_Drain
+ **************************************/
+static void THREADPOOL_Drain(THREADPOOL* pool)
+{
+    // Called and returns with the pool locked.
+    while (pool->nextTask < pool->numTasks)
+    {
+        size_t          index = pool->nextTask++;
+        THREADPOOL_TASK task  = pool->task;
+        void*           arg   = pool->arg;
+
+        pthread_mutex_unlock(&pool->lock);
+        task(arg, index);
+        pthread_mutex_lock(&pool->lock);
+
+        if (--pool->pending == 0)
+        {
+            pthread_cond_broadcast(&pool->done);
+        }
+    }
+}
+
+
+/**************************************
+ * THREADPOOL_Worker
+ **************************************/
+static void* THREADPOOL_Worker(void* arg)
+{
+    THREADPOOL* pool = (THREADPOOL*)arg;
+
+    pthread_mutex_lock(&pool->lock);
+    while (!pool->shutdown)
+    {
+        if (pool->nextTask < pool->numTasks)
+        {
+            THREADPOOL_Drain(pool);
+        }
+        else
+        {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+// End of file.
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * ThreadPool.h
+ * Copyright (c) 2026 Thomas Kerr
+ *
+ * Released under the MIT License (MIT).
+ * See http://opensource.org/licenses/MIT
+ *
+ * Modification History:
+ *
+ * 10/18/2026 - Tom Kerr
+ * Created.
+ ******************************************************************************/
+
+/**
+ * @file
+ * @brief
+ * The ThreadPool module runs a set of independent tasks on a fixed pool of
+ * POSIX threads.
+ *
+ * The pool is created once and reused, so splitting a job into tasks costs
+ * no thread creation.  THREADPOOL_Run() hands out task indexes 0 to
+ * numTasks - 1 to the worker threads and to the calling thread, and returns
+ * when all of them have finished.
+ *
+ * Intended for host builds (Linux, macOS, etc.).  Not for use on targets
+ * without pthreads, such as the Arduino.
+ *
+ * Only one THREADPOOL_Run() may be in progress on a pool at a time, and a
+ * task must not call THREADPOOL_Run() on its own pool.
+ */
+
+#ifndef _THREAD_POOL_H
+#define _THREAD_POOL_H
+
+/******************************************************************************
+ * System include files.
+ ******************************************************************************/
+#include <stddef.h>
+#include <pthread.h>
+
+
+/******************************************************************************
+ * Local include files.
+ ******************************************************************************/
+
+
+/******************************************************************************
+ * Public definitions.
+ ******************************************************************************/
+
+/**
+ * @brief
+ * A task function.  Called once for each index in the range
+ * 0 to (numTasks - 1) passed to THREADPOOL_Run().
+ */
+typedef void (*THREADPOOL_TASK)(void* arg, size_t index);
+
+/**
+ * @brief
+ * The thread pool structure.  Members are private to the module.
+ */
+typedef struct _THREADPOOL
+{
+    pthread_t*      threads;     //!< Worker threads
+    int             numThreads;  //!< Number of threads, including the caller of THREADPOOL_Run()
+    pthread_mutex_t lock;        //!< Protects the members below
+    pthread_cond_t  start;       //!< Signaled when tasks are posted or on shutdown
+    pthread_cond_t  done;        //!< Signaled when the last task finishes
+    THREADPOOL_TASK task;        //!< Current task function
+    void*           arg;         //!< Current task argument
+    size_t          numTasks;    //!< Number of tasks in the current run
+    size_t          nextTask;    //!< Next task index to hand out
+    size_t          pending;     //!< Tasks handed out or waiting, not yet finished
+    int             shutdown;    //!< Non-zero when the pool is being destroyed
+} THREADPOOL;
+
+
+/******************************************************************************
+ * Public functions.
+ ******************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Creates a thread pool.
+ *
+ * @param pool Pointer to the THREADPOOL structure to initialize
+ *
+ * @param numThreads The number of threads that run tasks, including the
+ * thread that calls THREADPOOL_Run().  Zero selects one per online CPU.
+ *
+ * @return 0 on success, -1 if the threads could not be created.
+ */
+int THREADPOOL_Create(THREADPOOL* pool, int numThreads);
+
+/**
+ * @brief
+ * Stops the worker threads and releases the pool's resources.
+ *
+ * @param pool Pointer to the pool
+ */
+void THREADPOOL_Destroy(THREADPOOL* pool);
+
+/**
+ * @brief
+ * Returns the number of threads that run tasks, including the caller.
+ *
+ * @param pool Pointer to the pool
+ *
+ * @return The number of threads.
+ */
+int THREADPOOL_Size(const THREADPOOL* pool);
+
+/**
+ * @brief
+ * Runs task(arg, index) for every index from 0 to (numTasks - 1) and waits
+ * for all of them to finish.
+ *
+ * Tasks run concurrently and in no particular order.  The calling thread
+ * runs tasks too.
+ *
+ * @param pool Pointer to the pool
+ *
+ * @param task The task function
+ *
+ * @param arg Argument passed to every call of the task function
+ *
+ * @param numTasks The number of tasks
+ */
+void THREADPOOL_Run(THREADPOOL* pool, THREADPOOL_TASK task, void* arg, size_t numTasks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _THREAD_POOL_H
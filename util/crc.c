@@ -16,6 +16,40 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_patch(), crc_patch_op() and crc_shift_op().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_iov().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_copy().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added the 16-entry nibble table variant (USE_CRC_NIBBLE).
+ *
+ * 10/18/2026 - Tom Kerr
+ * Reflected standards use reflected tables and a right-shifting
+ * remainder in crcFast, instead of reflecting every message byte.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Widened reflect() to crc_t for the CRC-64 standards.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_init(), crc_update() and crc_final().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_combine().  Message lengths are now size_t.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added the SSE4.2 crc32 instruction path for CRC-32C.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added PCLMULQDQ/VPCLMULQDQ folding kernels with CPUID dispatch.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added slicing-by-8/16 table lookups to crcFast (see CRC_SLICE_BY).
+ *
  * 08/30/2015 - Tom Kerr
  * Downloaded from the Barr Group website:
  *   http://www.barrgroup.com/Embedded-Systems/How-To/CRC-Calculation-C-Code
@@ -24,8 +58,14 @@
  **********************************************************************/
  
 #include <stdint.h>
+#include <stddef.h>
+#include <string.h>
 #include "crc.h"
 
+#if defined(USE_CRC_CLMUL) || defined(USE_CRC_SSE42)
+#include <immintrin.h>
+#endif
+
 
 /*
  * Derive parameters from the standard-specific parameters in crc.h.
@@ -36,17 +76,41 @@
 #if (REFLECT_DATA == 1)
 #undef  REFLECT_DATA
 #define REFLECT_DATA(X)			(reflect((X), 8))
+#define DATA_REFLECTED			1
 #else
 #undef  REFLECT_DATA
-#define REFLECT_DATA(X)			(uint32_t)(X)
+#define REFLECT_DATA(X)			(crc_t)(X)
+#define DATA_REFLECTED			0
 #endif
 
 #if (REFLECT_REMAINDER == 1)
 #undef  REFLECT_REMAINDER
 #define REFLECT_REMAINDER(X)	(reflect((X), WIDTH))
+#define REMAINDER_REFLECTED		1
 #else
 #undef  REFLECT_REMAINDER
-#define REFLECT_REMAINDER(X)	(uint32_t)(X)
+#define REFLECT_REMAINDER(X)	(crc_t)(X)
+#define REMAINDER_REFLECTED		0
+#endif
+
+/*
+ * The table-driven paths keep the remainder of a reflected standard
+ * reflected as well, so message bytes are used as-is: each byte meets the
+ * low end of the remainder, which shifts right.  FAST_BYTE(R, K) is the
+ * byte of remainder R that meets message byte K.
+ */
+#if (DATA_REFLECTED == 1)
+#define FAST_BYTE(R, K)			((uint8_t)((R) >> (8 * (K))))
+#define FAST_SHIFT8(R)			((crc_t)((R) >> 8))
+#else
+#define FAST_BYTE(R, K)			((uint8_t)((R) >> (WIDTH - 8 - 8 * (K))))
+#define FAST_SHIFT8(R)			((crc_t)((R) << 8))
+#endif
+
+#if (DATA_REFLECTED == REMAINDER_REFLECTED)
+#define FAST_FINAL(R)			((crc_t)((R) ^ FINAL_XOR_VALUE))
+#else
+#define FAST_FINAL(R)			((crc_t)(reflect((R), WIDTH) ^ FINAL_XOR_VALUE))
 #endif
 
 
@@ -57,15 +121,15 @@
  * Description: Reorder the bits of a binary sequence, by reflecting
  *				them about the middle position.
  *
- * Notes:		No checking is done that nBits <= 32.
+ * Notes:		No checking is done that nBits <= WIDTH.
  *
  * Returns:		The reflection of the original data.
  *
  *********************************************************************/
-static uint32_t
-reflect(uint32_t data, uint8_t nBits)
+static crc_t
+reflect(crc_t data, uint8_t nBits)
 {
-	uint32_t  reflection = 0x00000000;
+	crc_t     reflection = 0;
 	uint8_t   bit;
 
 	/*
@@ -78,7 +142,7 @@ reflect(uint32_t data, uint8_t nBits)
 		 */
 		if (data & 0x01)
 		{
-			reflection |= ((uint32_t)1 << ((nBits - 1) - bit));
+			reflection |= ((crc_t)1 << ((nBits - 1) - bit));
 		}
 
 		data = (data >> 1);
@@ -89,6 +153,49 @@ reflect(uint32_t data, uint8_t nBits)
 }	/* reflect() */
 
 
+/*********************************************************************
+ *
+ * Function:    crcSlowByte()
+ * 
+ * Description: Divide one message byte by the polynomial, a bit at
+ *				a time.
+ *
+ * Returns:		The remainder after the byte.
+ *
+ *********************************************************************/
+static crc_t
+crcSlowByte(crc_t remainder, uint8_t data)
+{
+	uint8_t  bit;
+
+    /*
+     * Bring the next byte into the remainder.
+     */
+    remainder ^= (REFLECT_DATA(data) << (WIDTH - 8));
+
+    /*
+     * Perform modulo-2 division, a bit at a time.
+     */
+    for (bit = 8; bit > 0; --bit)
+    {
+        /*
+         * Try to divide the current data bit.
+         */
+        if (remainder & TOPBIT)
+        {
+            remainder = (remainder << 1) ^ POLYNOMIAL;
+        }
+        else
+        {
+            remainder = (remainder << 1);
+        }
+    }
+
+    return (remainder);
+
+}   /* crcSlowByte() */
+
+
 /*********************************************************************
  *
  * Function:    crcSlow()
@@ -101,39 +208,17 @@ reflect(uint32_t data, uint8_t nBits)
  *
  *********************************************************************/
 crc_t
-crcSlow(const uint8_t* message, uint16_t nBytes)
+crcSlow(const uint8_t* message, size_t nBytes)
 {
     crc_t    remainder = INITIAL_REMAINDER;
-	uint16_t byte;
-	uint8_t  bit;
+	size_t   byte;
 
     /*
      * Perform modulo-2 division, a byte at a time.
      */
     for (byte = 0; byte < nBytes; ++byte)
     {
-        /*
-         * Bring the next byte into the remainder.
-         */
-        remainder ^= (REFLECT_DATA(message[byte]) << (WIDTH - 8));
-
-        /*
-         * Perform modulo-2 division, a bit at a time.
-         */
-        for (bit = 8; bit > 0; --bit)
-        {
-            /*
-             * Try to divide the current data bit.
-             */
-            if (remainder & TOPBIT)
-            {
-                remainder = (remainder << 1) ^ POLYNOMIAL;
-            }
-            else
-            {
-                remainder = (remainder << 1);
-            }
-        }
+        remainder = crcSlowByte(remainder, message[byte]);
     }
 
     /*
@@ -144,20 +229,223 @@ crcSlow(const uint8_t* message, uint16_t nBytes)
 }   /* crcSlow() */
 
 
+/*********************************************************************
+ *
+ * Function:    crcMultMod()
+ * 
+ * Description: Multiply two remainders modulo the polynomial.
+ *
+ * Notes:		Horner's rule over the bits of a, most significant
+ *				first.
+ *
+ * Returns:		a * b mod POLYNOMIAL.
+ *
+ *********************************************************************/
+static crc_t
+crcMultMod(crc_t a, crc_t b)
+{
+    crc_t product = 0;
+    crc_t bit;
+
+    for (bit = TOPBIT; bit != 0; bit >>= 1)
+    {
+        if (product & TOPBIT)
+        {
+            product = (product << 1) ^ POLYNOMIAL;
+        }
+        else
+        {
+            product = (product << 1);
+        }
+
+        if (a & bit)
+        {
+            product ^= b;
+        }
+    }
+
+    return (product);
+
+}   /* crcMultMod() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcXpow8n()
+ * 
+ * Description: Compute x^(8 * nBytes) modulo the polynomial, the
+ *				operator that moves a remainder past nBytes zero bytes.
+ *
+ * Notes:		Square-and-multiply, O(log nBytes).
+ *
+ * Returns:		x^(8 * nBytes) mod POLYNOMIAL.
+ *
+ *********************************************************************/
+static crc_t
+crcXpow8n(size_t nBytes)
+{
+    crc_t result = 1;
+    crc_t square = (crc_t)1 << 8;
+
+    for ( ; nBytes != 0; nBytes >>= 1)
+    {
+        if (nBytes & 1)
+        {
+            result = crcMultMod(result, square);
+        }
+        square = crcMultMod(square, square);
+    }
+
+    return (result);
+
+}   /* crcXpow8n() */
+
+
+/*********************************************************************
+ *
+ * Function:    crc_combine()
+ * 
+ * Description: Compute the CRC of two concatenated messages from the
+ *				CRCs of each.
+ *
+ * Notes:		The remainder after A, with the initial remainder
+ *				that B was computed with cancelled out, is moved past
+ *				lenB bytes and added to B's remainder.
+ *
+ * Returns:		The CRC of A followed by B.
+ *
+ *********************************************************************/
+crc_t
+crc_combine(crc_t crcA, crc_t crcB, size_t lenB)
+{
+    crc_t remainderA = (crc_t)REFLECT_REMAINDER(crcA ^ FINAL_XOR_VALUE) ^ INITIAL_REMAINDER;
+    crc_t remainderB = (crc_t)REFLECT_REMAINDER(crcB ^ FINAL_XOR_VALUE);
+    crc_t remainder  = crcMultMod(remainderA, crcXpow8n(lenB)) ^ remainderB;
+
+    return (REFLECT_REMAINDER(remainder) ^ FINAL_XOR_VALUE);
+
+}   /* crc_combine() */
+
+
+/*********************************************************************
+ *
+ * Function:    crc_shift_op()
+ * 
+ * Description: Compute the operator that moves a change in a message
+ *				past the nBytes that follow it.
+ *
+ * Notes:		O(log nBytes).
+ *
+ * Returns:		x^(8 * nBytes) mod POLYNOMIAL.
+ *
+ *********************************************************************/
+crc_t
+crc_shift_op(size_t nBytes)
+{
+    return (crcXpow8n(nBytes));
+
+}   /* crc_shift_op() */
+
+
+/*********************************************************************
+ *
+ * Function:    crc_patch_op()
+ * 
+ * Description: Update the CRC of a message after some of its bytes
+ *				have changed, given the shift operator for the bytes
+ *				that follow the change.
+ *
+ * Notes:		A CRC is linear in the message apart from its initial
+ *				remainder and final XOR, which cancel out of the
+ *				difference: the CRC changes by the remainder of the
+ *				changed bits alone, moved past the rest of the
+ *				message.
+ *
+ * Returns:		The CRC of the changed message.
+ *
+ *********************************************************************/
+crc_t
+crc_patch_op(crc_t crc, crc_t shiftOp, const uint8_t* oldData, const uint8_t* newData, size_t nChanged)
+{
+    crc_t    delta = 0;
+    size_t   byte;
+
+
+    for (byte = 0; byte < nChanged; ++byte)
+    {
+        delta = crcSlowByte(delta, oldData[byte] ^ newData[byte]);
+    }
+
+    delta = crcMultMod(delta, shiftOp);
+
+    return (crc ^ (crc_t)REFLECT_REMAINDER(delta));
+
+}   /* crc_patch_op() */
+
+
+/*********************************************************************
+ *
+ * Function:    crc_patch()
+ * 
+ * Description: Update the CRC of a message after nChanged bytes at
+ *				offset have changed from oldData to newData.
+ *
+ * Notes:		O(nChanged + log nBytes), independent of the rest of
+ *				the message.
+ *
+ * Returns:		The CRC of the changed message.
+ *
+ *********************************************************************/
+crc_t
+crc_patch(crc_t crc, size_t nBytes, size_t offset,
+          const uint8_t* oldData, const uint8_t* newData, size_t nChanged)
+{
+    return (crc_patch_op(crc, crc_shift_op(nBytes - offset - nChanged), oldData, newData, nChanged));
+
+}   /* crc_patch() */
+
+
 #if defined(USE_CRC_FAST)
 
-static crc_t crcTable[256];
+/*
+ * crcTable[0] is the classic byte-wise table.  crcTable[k] holds the
+ * remainder of each dividend followed by k zero bytes, which lets
+ * crcFast fold CRC_SLICE_BY message bytes per iteration.
+ */
+#if defined(USE_CRC_NIBBLE)
+/*
+ * crcNibble holds the remainder of each 4-bit dividend; a byte takes two
+ * lookups.
+ */
+static crc_t crcNibble[16];
+#else
+static crc_t crcTable[CRC_SLICE_BY][256];
+#endif
+
+/*
+ * INITIAL_REMAINDER in the form the table-driven paths use.
+ */
+static crc_t crcStart;
+
+#if defined(USE_CRC_CLMUL)
+static void crcClmulInit(void);
+#endif
+
+#if defined(USE_CRC_SSE42)
+static void crcSse42Init(void);
+#endif
 
 
 /*********************************************************************
  *
  * Function:    crcInit()
  * 
- * Description: Populate the partial CRC lookup table.
+ * Description: Populate the partial CRC lookup tables.
  *
  * Notes:		This function must be rerun any time the CRC standard
  *				is changed.  If desired, it can be run "offline" and
  *				the table results stored in an embedded system's ROM.
+ *				For reflected standards the tables are reflected too.
  *
  * Returns:		None defined.
  *
@@ -168,13 +456,77 @@ crcInit(void)
     crc_t   remainder;
 	crc_t   dividend;
 	uint8_t bit;
+	uint8_t slice;
+#if (DATA_REFLECTED == 1)
+	crc_t   polynomial = reflect(POLYNOMIAL, WIDTH);
+#endif
+
+
+#if defined(USE_CRC_NIBBLE)
+    /*
+     * Compute the remainder of each possible 4-bit dividend.
+     */
+    for (dividend = 0; dividend < 16; ++dividend)
+    {
+#if (DATA_REFLECTED == 1)
+        remainder = dividend;
+
+        for (bit = 4; bit > 0; --bit)
+        {
+            if (remainder & 1)
+            {
+                remainder = (remainder >> 1) ^ polynomial;
+            }
+            else
+            {
+                remainder = (remainder >> 1);
+            }
+        }
+#else
+        remainder = dividend << (WIDTH - 4);
+
+        for (bit = 4; bit > 0; --bit)
+        {
+            if (remainder & TOPBIT)
+            {
+                remainder = (remainder << 1) ^ POLYNOMIAL;
+            }
+            else
+            {
+                remainder = (remainder << 1);
+            }
+        }
+#endif
 
+        crcNibble[dividend] = remainder;
+    }
 
+    (void)slice;
+#else
     /*
      * Compute the remainder of each possible dividend.
      */
     for (dividend = 0; dividend < 256; ++dividend)
     {
+#if (DATA_REFLECTED == 1)
+        /*
+         * Mirror image of the division below: the dividend enters at
+         * the low end and the remainder shifts right.
+         */
+        remainder = dividend;
+
+        for (bit = 8; bit > 0; --bit)
+        {
+            if (remainder & 1)
+            {
+                remainder = (remainder >> 1) ^ polynomial;
+            }
+            else
+            {
+                remainder = (remainder >> 1);
+            }
+        }
+#else
         /*
          * Start with the dividend followed by zeros.
          */
@@ -197,49 +549,1007 @@ crcInit(void)
                 remainder = (remainder << 1);
             }
         }
+#endif
 
         /*
          * Store the result into the table.
          */
-        crcTable[dividend] = remainder;
+        crcTable[0][dividend] = remainder;
+    }
+
+    /*
+     * Each further table appends one more zero byte to the dividend.
+     */
+    for (slice = 1; slice < CRC_SLICE_BY; ++slice)
+    {
+        for (dividend = 0; dividend < 256; ++dividend)
+        {
+            remainder = crcTable[slice - 1][dividend];
+            crcTable[slice][dividend] = crcTable[0][FAST_BYTE(remainder, 0)] ^ FAST_SHIFT8(remainder);
+        }
     }
+#endif // USE_CRC_NIBBLE
+
+#if (DATA_REFLECTED == 1)
+    crcStart = reflect(INITIAL_REMAINDER, WIDTH);
+#else
+    crcStart = INITIAL_REMAINDER;
+#endif
+
+#if defined(USE_CRC_CLMUL)
+    /*
+     * Pick the folding kernel for this CPU.
+     */
+    crcClmulInit();
+#endif
+
+#if defined(USE_CRC_SSE42)
+    crcSse42Init();
+#endif
 
 }   /* crcInit() */
 
 
+#if (CRC_SLICE_BY > 1)
+
 /*********************************************************************
  *
- * Function:    crcFast()
+ * Function:    crcSlice()
  * 
- * Description: Compute the CRC of a given message.
+ * Description: Divide CRC_SLICE_BY message bytes by the polynomial.
  *
- * Notes:		crcInit() must be called first.
+ * Notes:		The leading WIDTH / 8 bytes absorb the current
+ *				remainder; each byte is then looked up in the table
+ *				matching the number of bytes that follow it.  The
+ *				lookups are independent, so they overlap in the
+ *				pipeline instead of forming one long dependency chain.
  *
- * Returns:		The CRC of the message.
+ * Returns:		The remainder after the block.
  *
  *********************************************************************/
-crc_t
-crcFast(const uint8_t* message, uint16_t nBytes)
+static crc_t
+crcSlice(crc_t remainder, const uint8_t* message)
 {
-    crc_t    remainder = INITIAL_REMAINDER;
-    uint8_t  data;
-	uint16_t byte;
+    crc_t   result = 0;
+    uint8_t data;
+    uint8_t byte;
 
+    for (byte = 0; byte < WIDTH / 8; ++byte)
+    {
+        data = message[byte] ^ FAST_BYTE(remainder, byte);
+        result ^= crcTable[CRC_SLICE_BY - 1 - byte][data];
+    }
 
-    /*
-     * Divide the message by the polynomial, a byte at a time.
-     */
-    for (byte = 0; byte < nBytes; ++byte)
+    for ( ; byte < CRC_SLICE_BY; ++byte)
     {
-        data = REFLECT_DATA(message[byte]) ^ (remainder >> (WIDTH - 8));
-  		remainder = crcTable[data] ^ (remainder << 8);
+        data = message[byte];
+        result ^= crcTable[CRC_SLICE_BY - 1 - byte][data];
     }
 
-    /*
-     * The final remainder is the CRC.
-     */
-    return (REFLECT_REMAINDER(remainder) ^ FINAL_XOR_VALUE);
+    return (result);
 
-}   /* crcFast() */
+}   /* crcSlice() */
+
+#endif // CRC_SLICE_BY > 1
+
+
+/*********************************************************************
+ *
+ * Function:    crcTableByte()
+ * 
+ * Description: Divide one message byte by the polynomial using the
+ *				lookup table.
+ *
+ * Returns:		The remainder after the byte.
+ *
+ *********************************************************************/
+static crc_t
+crcTableByte(crc_t remainder, uint8_t data)
+{
+#if defined(USE_CRC_NIBBLE)
+    /*
+     * Two lookups, a nibble at a time.
+     */
+#if (DATA_REFLECTED == 1)
+    remainder ^= data;
+    remainder = crcNibble[remainder & 0x0F] ^ (remainder >> 4);
+    remainder = crcNibble[remainder & 0x0F] ^ (remainder >> 4);
+#else
+    remainder ^= (crc_t)data << (WIDTH - 8);
+    remainder = crcNibble[remainder >> (WIDTH - 4)] ^ (crc_t)(remainder << 4);
+    remainder = crcNibble[remainder >> (WIDTH - 4)] ^ (crc_t)(remainder << 4);
+#endif
+    return (remainder);
+#else
+    data ^= FAST_BYTE(remainder, 0);
+    return (crcTable[0][data] ^ FAST_SHIFT8(remainder));
+#endif
+
+}   /* crcTableByte() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcTableUpdate()
+ * 
+ * Description: Divide a message by the polynomial using the lookup
+ *				tables, starting from the given remainder.
+ *
+ * Notes:		No initial remainder or final XOR is applied.  The
+ *				remainder is reflected for reflected standards.
+ *
+ * Returns:		The remainder after the message.
+ *
+ *********************************************************************/
+static crc_t
+crcTableUpdate(crc_t remainder, const uint8_t* message, size_t nBytes)
+{
+#if (CRC_SLICE_BY > 1)
+    /*
+     * Divide the bulk of the message CRC_SLICE_BY bytes at a time.
+     */
+    for ( ; nBytes >= CRC_SLICE_BY; nBytes -= CRC_SLICE_BY)
+    {
+        remainder = crcSlice(remainder, message);
+        message += CRC_SLICE_BY;
+    }
+#endif
+
+    /*
+     * Divide the rest of the message by the polynomial, a byte at a time.
+     */
+    for ( ; nBytes > 0; --nBytes)
+    {
+        remainder = crcTableByte(remainder, *message++);
+    }
+
+    return (remainder);
+
+}   /* crcTableUpdate() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcTableCopy()
+ * 
+ * Description: Copy a message and divide it by the polynomial using
+ *				the lookup tables, in one pass.
+ *
+ * Notes:		Each block is loaded once into a local, which the
+ *				compiler keeps in registers, and is both stored to
+ *				the destination and looked up from there.
+ *
+ * Returns:		The remainder after the message.
+ *
+ *********************************************************************/
+static crc_t
+crcTableCopy(crc_t remainder, uint8_t* dst, const uint8_t* src, size_t nBytes)
+{
+    uint8_t  data;
+
+#if (CRC_SLICE_BY > 1)
+    uint8_t  block[CRC_SLICE_BY];
+
+    for ( ; nBytes >= CRC_SLICE_BY; nBytes -= CRC_SLICE_BY)
+    {
+        memcpy(block, src, CRC_SLICE_BY);
+        memcpy(dst, block, CRC_SLICE_BY);
+        remainder = crcSlice(remainder, block);
+        src += CRC_SLICE_BY;
+        dst += CRC_SLICE_BY;
+    }
+#endif
+
+    for ( ; nBytes > 0; --nBytes)
+    {
+        data = *src++;
+        *dst++ = data;
+        remainder = crcTableByte(remainder, data);
+    }
+
+    return (remainder);
+
+}   /* crcTableCopy() */
+
+
+#if defined(USE_CRC_CLMUL)
+
+/*
+ * Folding kernels.
+ *
+ * A 16-byte block X of the message is a polynomial H * x^64 + L.  Moving
+ * it 8 * D bits further along the message multiplies it by x^(8 * D),
+ * and modulo the CRC polynomial P that is
+ *
+ *     H * (x^(8 * D + 64) mod P)  +  L * (x^(8 * D) mod P)
+ *
+ * two 64 x 64-bit carry-less products whose sum is again at most 128 bits.
+ * Folding the running block forward and XOR-ing in the data it lands on
+ * keeps a 16-byte block congruent to everything consumed so far; the last
+ * one is then divided by the table path like ordinary message bytes.
+ *
+ * For reflected standards the bytes are loaded as-is (bit 0 of the first
+ * byte is the highest power) and the constants are bit-reversed, taken
+ * one power lower to absorb the one-bit offset of a reflected product.
+ * Otherwise the bytes of each block are swapped so the first message byte
+ * lands in the most significant position.
+ */
+#define CLMUL_NONE		0
+#define CLMUL_SSE		1
+#define CLMUL_AVX512	2
+
+static uint8_t crcClmulLevel = CLMUL_NONE;
+
+/*
+ * Fold constants for a distance of 16, 64 and 256 bytes.  Each holds the
+ * multiplier for the low quadword of a block in element 0 and for the
+ * high quadword in element 1, ready for _mm_clmulepi64_si128.
+ */
+static uint64_t crcFold16[2];
+static uint64_t crcFold64[2];
+static uint64_t crcFold256[2];
+
+
+/*********************************************************************
+ *
+ * Function:    crcXpowMod()
+ * 
+ * Description: Compute x^n modulo the polynomial.
+ *
+ * Notes:		Only run from crcInit(), so a bit at a time is fine.
+ *
+ * Returns:		x^n mod POLYNOMIAL.
+ *
+ *********************************************************************/
+static crc_t
+crcXpowMod(uint32_t n)
+{
+    crc_t remainder = 1;
+
+    while (n--)
+    {
+        if (remainder & TOPBIT)
+        {
+            remainder = (remainder << 1) ^ POLYNOMIAL;
+        }
+        else
+        {
+            remainder = (remainder << 1);
+        }
+    }
+
+    return (remainder);
+
+}   /* crcXpowMod() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcFoldConstants()
+ * 
+ * Description: Compute the pair of fold constants for a distance of
+ *				nBytes.
+ *
+ * Returns:		None defined.
+ *
+ *********************************************************************/
+static void
+crcFoldConstants(uint64_t k[2], uint32_t nBytes)
+{
+    uint32_t bits = 8 * nBytes;
+
+#if (DATA_REFLECTED == 1)
+    uint64_t hi = crcXpowMod(bits + 64 - 1);
+    uint64_t lo = crcXpowMod(bits - 1);
+    uint64_t rhi = 0;
+    uint64_t rlo = 0;
+    uint8_t  bit;
+
+    for (bit = 0; bit < 64; ++bit)
+    {
+        rhi = (rhi << 1) | ((hi >> bit) & 1);
+        rlo = (rlo << 1) | ((lo >> bit) & 1);
+    }
+
+    /* The low quadword of a reflected block holds the high powers. */
+    k[0] = rhi;
+    k[1] = rlo;
+#else
+    k[0] = crcXpowMod(bits);
+    k[1] = crcXpowMod(bits + 64);
+#endif
+
+}   /* crcFoldConstants() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcInject()
+ * 
+ * Description: XOR a remainder into the leading bytes of a block so
+ *				the block can be divided starting from zero.
+ *
+ * Returns:		None defined.
+ *
+ *********************************************************************/
+static void
+crcInject(uint8_t* block, crc_t remainder)
+{
+    uint8_t byte;
+
+    for (byte = 0; byte < WIDTH / 8; ++byte)
+    {
+        block[byte] ^= FAST_BYTE(remainder, byte);
+    }
+
+}   /* crcInject() */
+
+
+#if (DATA_REFLECTED == 1)
+#define CLMUL_LOAD(P)		_mm_loadu_si128((const __m128i*)(P))
+#define CLMUL_STORE(P, X)	_mm_storeu_si128((__m128i*)(P), (X))
+#else
+#define CLMUL_SWAP			_mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+#define CLMUL_LOAD(P)		_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(P)), CLMUL_SWAP)
+#define CLMUL_STORE(P, X)	_mm_storeu_si128((__m128i*)(P), _mm_shuffle_epi8((X), CLMUL_SWAP))
+#endif
+
+#define CLMUL_FOLD(X, K)	_mm_xor_si128(_mm_clmulepi64_si128((X), (K), 0x00), \
+										  _mm_clmulepi64_si128((X), (K), 0x11))
+
+
+/*********************************************************************
+ *
+ * Function:    crcFoldFinish()
+ * 
+ * Description: Fold the remaining 16-byte blocks into x, then divide
+ *				x and the last partial block with the table path.
+ *
+ * Returns:		The remainder after the message.
+ *
+ *********************************************************************/
+__attribute__((target("pclmul,ssse3")))
+static crc_t
+crcFoldFinish(__m128i x, const uint8_t* message, size_t nBytes)
+{
+    const __m128i k16 = _mm_loadu_si128((const __m128i*)crcFold16);
+    uint8_t       block[16];
+
+    for ( ; nBytes >= 16; nBytes -= 16)
+    {
+        x = _mm_xor_si128(CLMUL_FOLD(x, k16), CLMUL_LOAD(message));
+        message += 16;
+    }
+
+    CLMUL_STORE(block, x);
+    return (crcTableUpdate(crcTableUpdate(0, block, 16), message, nBytes));
+
+}   /* crcFoldFinish() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcFoldSse()
+ * 
+ * Description: Divide a message of at least 64 bytes with PCLMULQDQ,
+ *				using four independent 16-byte accumulators.
+ *
+ * Returns:		The remainder after the message.
+ *
+ *********************************************************************/
+__attribute__((target("pclmul,ssse3")))
+static crc_t
+crcFoldSse(crc_t remainder, const uint8_t* message, size_t nBytes)
+{
+    const __m128i k16 = _mm_loadu_si128((const __m128i*)crcFold16);
+    const __m128i k64 = _mm_loadu_si128((const __m128i*)crcFold64);
+    __m128i       x0, x1, x2, x3;
+    uint8_t       block[16];
+
+    memcpy(block, message, 16);
+    crcInject(block, remainder);
+
+    x0 = CLMUL_LOAD(block);
+    x1 = CLMUL_LOAD(message + 16);
+    x2 = CLMUL_LOAD(message + 32);
+    x3 = CLMUL_LOAD(message + 48);
+    message += 64;
+    nBytes  -= 64;
+
+    for ( ; nBytes >= 64; nBytes -= 64)
+    {
+        x0 = _mm_xor_si128(CLMUL_FOLD(x0, k64), CLMUL_LOAD(message));
+        x1 = _mm_xor_si128(CLMUL_FOLD(x1, k64), CLMUL_LOAD(message + 16));
+        x2 = _mm_xor_si128(CLMUL_FOLD(x2, k64), CLMUL_LOAD(message + 32));
+        x3 = _mm_xor_si128(CLMUL_FOLD(x3, k64), CLMUL_LOAD(message + 48));
+        message += 64;
+    }
+
+    x0 = _mm_xor_si128(CLMUL_FOLD(x0, k16), x1);
+    x0 = _mm_xor_si128(CLMUL_FOLD(x0, k16), x2);
+    x0 = _mm_xor_si128(CLMUL_FOLD(x0, k16), x3);
+
+    return (crcFoldFinish(x0, message, nBytes));
+
+}   /* crcFoldSse() */
+
+
+#if (DATA_REFLECTED == 1)
+#define CLMUL_LOAD512(P)	_mm512_loadu_si512((const void*)(P))
+#else
+#define CLMUL_LOAD512(P)	_mm512_shuffle_epi8(_mm512_loadu_si512((const void*)(P)), \
+											_mm512_broadcast_i32x4(CLMUL_SWAP))
+#endif
+
+#define CLMUL_FOLD512(X, K)	_mm512_xor_si512(_mm512_clmulepi64_epi128((X), (K), 0x00), \
+											 _mm512_clmulepi64_epi128((X), (K), 0x11))
+
+
+/*********************************************************************
+ *
+ * Function:    crcFoldAvx512()
+ * 
+ * Description: Divide a message of at least 256 bytes with VPCLMULQDQ,
+ *				using four 64-byte accumulators.
+ *
+ * Returns:		The remainder after the message.
+ *
+ *********************************************************************/
+__attribute__((target("avx512f,avx512bw,avx512vl,vpclmulqdq,pclmul,ssse3")))
+static crc_t
+crcFoldAvx512(crc_t remainder, const uint8_t* message, size_t nBytes)
+{
+    const __m512i k64  = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)crcFold64));
+    const __m512i k256 = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)crcFold256));
+    const __m128i k16  = _mm_loadu_si128((const __m128i*)crcFold16);
+    __m512i       z0, z1, z2, z3;
+    __m128i       x;
+    uint8_t       block[64];
+
+    memcpy(block, message, 64);
+    crcInject(block, remainder);
+
+    z0 = CLMUL_LOAD512(block);
+    z1 = CLMUL_LOAD512(message + 64);
+    z2 = CLMUL_LOAD512(message + 128);
+    z3 = CLMUL_LOAD512(message + 192);
+    message += 256;
+    nBytes  -= 256;
+
+    for ( ; nBytes >= 256; nBytes -= 256)
+    {
+        z0 = _mm512_xor_si512(CLMUL_FOLD512(z0, k256), CLMUL_LOAD512(message));
+        z1 = _mm512_xor_si512(CLMUL_FOLD512(z1, k256), CLMUL_LOAD512(message + 64));
+        z2 = _mm512_xor_si512(CLMUL_FOLD512(z2, k256), CLMUL_LOAD512(message + 128));
+        z3 = _mm512_xor_si512(CLMUL_FOLD512(z3, k256), CLMUL_LOAD512(message + 192));
+        message += 256;
+    }
+
+    z0 = _mm512_xor_si512(CLMUL_FOLD512(z0, k64), z1);
+    z0 = _mm512_xor_si512(CLMUL_FOLD512(z0, k64), z2);
+    z0 = _mm512_xor_si512(CLMUL_FOLD512(z0, k64), z3);
+
+    for ( ; nBytes >= 64; nBytes -= 64)
+    {
+        z0 = _mm512_xor_si512(CLMUL_FOLD512(z0, k64), CLMUL_LOAD512(message));
+        message += 64;
+    }
+
+    /*
+     * Collapse the four lanes of the last accumulator into one.
+     */
+    x = _mm_xor_si128(CLMUL_FOLD(_mm512_extracti32x4_epi32(z0, 0), k16), _mm512_extracti32x4_epi32(z0, 1));
+    x = _mm_xor_si128(CLMUL_FOLD(x, k16), _mm512_extracti32x4_epi32(z0, 2));
+    x = _mm_xor_si128(CLMUL_FOLD(x, k16), _mm512_extracti32x4_epi32(z0, 3));
+
+    return (crcFoldFinish(x, message, nBytes));
+
+}   /* crcFoldAvx512() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcClmulInit()
+ * 
+ * Description: Select a folding kernel for this CPU and compute its
+ *				constants.
+ *
+ * Returns:		None defined.
+ *
+ *********************************************************************/
+static void
+crcClmulInit(void)
+{
+    crcFoldConstants(crcFold16, 16);
+    crcFoldConstants(crcFold64, 64);
+    crcFoldConstants(crcFold256, 256);
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("vpclmulqdq") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vl"))
+    {
+        crcClmulLevel = CLMUL_AVX512;
+    }
+    else if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3"))
+    {
+        crcClmulLevel = CLMUL_SSE;
+    }
+    else
+    {
+        crcClmulLevel = CLMUL_NONE;
+    }
+
+}   /* crcClmulInit() */
+
+#endif // USE_CRC_CLMUL
+
+
+#if defined(USE_CRC_SSE42)
+
+/*
+ * The crc32 instruction has a latency of three cycles but can start one
+ * per cycle, so the message is cut into three equal streams that are run
+ * side by side.  Stream CRCs are then merged by shifting the earlier one
+ * over the length of a stream (multiplying by x^(8 * len) mod P), which
+ * the tables below do with four lookups.
+ */
+#define SSE42_LONG		8192
+#define SSE42_SHORT		256
+
+static uint8_t  crcHasSse42 = 0;
+static uint32_t crcShiftLong[4][256];
+static uint32_t crcShiftShort[4][256];
+
+
+/*********************************************************************
+ *
+ * Function:    crcMultModReflected()
+ * 
+ * Description: Multiply two reflected polynomials modulo the reflected
+ *				polynomial.
+ *
+ * Returns:		a * b mod POLYNOMIAL, reflected.
+ *
+ *********************************************************************/
+static uint32_t
+crcMultModReflected(uint32_t a, uint32_t b, uint32_t poly)
+{
+    uint32_t product = 0;
+    uint32_t bit;
+
+    for (bit = 0x80000000; bit != 0; bit >>= 1)
+    {
+        if (a & bit)
+        {
+            product ^= b;
+        }
+        b = (b & 1) ? ((b >> 1) ^ poly) : (b >> 1);
+    }
+
+    return (product);
+
+}   /* crcMultModReflected() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcShiftTable()
+ * 
+ * Description: Build the table that shifts a reflected CRC over
+ *				nBytes zero bytes.
+ *
+ * Returns:		None defined.
+ *
+ *********************************************************************/
+static void
+crcShiftTable(uint32_t table[4][256], uint32_t nBytes, uint32_t poly)
+{
+    uint32_t xpow = 0x80000000;  /* x^0, reflected */
+    uint32_t square = 0x40000000;  /* x^1, reflected */
+    uint32_t n = 8 * nBytes;
+    uint32_t byte;
+    uint32_t value;
+
+    /*
+     * x^(8 * nBytes) by repeated squaring.
+     */
+    for ( ; n != 0; n >>= 1)
+    {
+        if (n & 1)
+        {
+            xpow = crcMultModReflected(xpow, square, poly);
+        }
+        square = crcMultModReflected(square, square, poly);
+    }
+
+    for (value = 0; value < 256; ++value)
+    {
+        for (byte = 0; byte < 4; ++byte)
+        {
+            table[byte][value] = crcMultModReflected(xpow, value << (8 * byte), poly);
+        }
+    }
+
+}   /* crcShiftTable() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcShift()
+ * 
+ * Description: Apply a shift table to a reflected CRC.
+ *
+ * Returns:		The shifted CRC.
+ *
+ *********************************************************************/
+static uint32_t
+crcShift(const uint32_t table[4][256], uint32_t crc)
+{
+    return (table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^
+            table[2][(crc >> 16) & 0xFF] ^ table[3][crc >> 24]);
+
+}   /* crcShift() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcSse42()
+ * 
+ * Description: Divide a message by the CRC-32C polynomial with the
+ *				SSE4.2 crc32 instruction.
+ *
+ * Returns:		The remainder after the message.
+ *
+ *********************************************************************/
+__attribute__((target("sse4.2")))
+static crc_t
+crcSse42(crc_t remainder, const uint8_t* message, size_t nBytes)
+{
+    uint64_t crc0 = remainder;
+    uint64_t crc1;
+    uint64_t crc2;
+    uint64_t word0;
+    uint64_t word1;
+    uint64_t word2;
+    const uint8_t* end;
+
+    /*
+     * Align to eight bytes.
+     */
+    while ((nBytes > 0) && (((uintptr_t)message & 7) != 0))
+    {
+        crc0 = _mm_crc32_u8((uint32_t)crc0, *message++);
+        --nBytes;
+    }
+
+#if defined(__x86_64__)
+    /*
+     * Three interleaved streams of SSE42_LONG, then SSE42_SHORT bytes.
+     */
+    while (nBytes >= 3 * SSE42_LONG)
+    {
+        crc1 = 0;
+        crc2 = 0;
+        for (end = message + SSE42_LONG; message < end; message += 8)
+        {
+            memcpy(&word0, message, 8);
+            memcpy(&word1, message + SSE42_LONG, 8);
+            memcpy(&word2, message + 2 * SSE42_LONG, 8);
+            crc0 = _mm_crc32_u64(crc0, word0);
+            crc1 = _mm_crc32_u64(crc1, word1);
+            crc2 = _mm_crc32_u64(crc2, word2);
+        }
+        crc0 = crcShift(crcShiftLong, (uint32_t)crc0) ^ crc1;
+        crc0 = crcShift(crcShiftLong, (uint32_t)crc0) ^ crc2;
+        message += 2 * SSE42_LONG;
+        nBytes  -= 3 * SSE42_LONG;
+    }
+
+    while (nBytes >= 3 * SSE42_SHORT)
+    {
+        crc1 = 0;
+        crc2 = 0;
+        for (end = message + SSE42_SHORT; message < end; message += 8)
+        {
+            memcpy(&word0, message, 8);
+            memcpy(&word1, message + SSE42_SHORT, 8);
+            memcpy(&word2, message + 2 * SSE42_SHORT, 8);
+            crc0 = _mm_crc32_u64(crc0, word0);
+            crc1 = _mm_crc32_u64(crc1, word1);
+            crc2 = _mm_crc32_u64(crc2, word2);
+        }
+        crc0 = crcShift(crcShiftShort, (uint32_t)crc0) ^ crc1;
+        crc0 = crcShift(crcShiftShort, (uint32_t)crc0) ^ crc2;
+        message += 2 * SSE42_SHORT;
+        nBytes  -= 3 * SSE42_SHORT;
+    }
+
+    for ( ; nBytes >= 8; nBytes -= 8)
+    {
+        memcpy(&word0, message, 8);
+        crc0 = _mm_crc32_u64(crc0, word0);
+        message += 8;
+    }
+#else
+    (void)crc1;
+    (void)crc2;
+    (void)word0;
+    (void)word1;
+    (void)word2;
+    (void)end;
+#endif
+
+    while (nBytes-- > 0)
+    {
+        crc0 = _mm_crc32_u8((uint32_t)crc0, *message++);
+    }
+
+    return ((crc_t)crc0);
+
+}   /* crcSse42() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcSse42Init()
+ * 
+ * Description: Check for SSE4.2 and build the stream shift tables.
+ *
+ * Returns:		None defined.
+ *
+ *********************************************************************/
+static void
+crcSse42Init(void)
+{
+    uint32_t poly = reflect(POLYNOMIAL, 32);
+
+    crcShiftTable(crcShiftLong, SSE42_LONG, poly);
+    crcShiftTable(crcShiftShort, SSE42_SHORT, poly);
+
+    __builtin_cpu_init();
+    crcHasSse42 = __builtin_cpu_supports("sse4.2") ? 1 : 0;
+
+}   /* crcSse42Init() */
+
+#endif // USE_CRC_SSE42
+
+
+#if defined(USE_CRC_CLMUL) || defined(USE_CRC_SSE42)
+
+/*
+ * Block size for crc_copy() on the accelerated paths: small enough that
+ * a copied block is still in the L1 cache when it is divided, large
+ * enough to amortize each kernel's setup and final reduction.
+ */
+#define CRC_COPY_BLOCK		16384
+
+
+/*********************************************************************
+ *
+ * Function:    crcAccelerated()
+ * 
+ * Description: Check whether crcUpdate() has a faster kernel than the
+ *				lookup tables on this CPU.
+ *
+ * Returns:		Non-zero if it does.
+ *
+ *********************************************************************/
+static int
+crcAccelerated(void)
+{
+#if defined(USE_CRC_SSE42)
+    if (crcHasSse42)
+    {
+        return (1);
+    }
+#endif
+#if defined(USE_CRC_CLMUL)
+    if (crcClmulLevel != CLMUL_NONE)
+    {
+        return (1);
+    }
+#endif
+    return (0);
+
+}   /* crcAccelerated() */
+
+#endif
+
+
+/*********************************************************************
+ *
+ * Function:    crcUpdate()
+ * 
+ * Description: Divide a message by the polynomial with the fastest
+ *				kernel available, starting from the given remainder.
+ *
+ * Returns:		The remainder after the message.
+ *
+ *********************************************************************/
+static crc_t
+crcUpdate(crc_t remainder, const uint8_t* message, size_t nBytes)
+{
+#if defined(USE_CRC_SSE42) && defined(USE_CRC_CLMUL)
+    /*
+     * Only the VPCLMULQDQ fold outruns the crc32 instruction, and only
+     * once there is enough data to amortize its final reduction.
+     */
+    if (crcHasSse42 && ((crcClmulLevel != CLMUL_AVX512) || (nBytes < 1024)))
+    {
+        return (crcSse42(remainder, message, nBytes));
+    }
+#elif defined(USE_CRC_SSE42)
+    if (crcHasSse42)
+    {
+        return (crcSse42(remainder, message, nBytes));
+    }
+#endif
+
+#if defined(USE_CRC_CLMUL)
+    if ((crcClmulLevel == CLMUL_AVX512) && (nBytes >= 256))
+    {
+        return (crcFoldAvx512(remainder, message, nBytes));
+    }
+    if ((crcClmulLevel != CLMUL_NONE) && (nBytes >= 64))
+    {
+        return (crcFoldSse(remainder, message, nBytes));
+    }
+#endif
+
+    return (crcTableUpdate(remainder, message, nBytes));
+
+}   /* crcUpdate() */
+
+
+/*********************************************************************
+ *
+ * Function:    crcFast()
+ * 
+ * Description: Compute the CRC of a given message.
+ *
+ * Notes:		crcInit() must be called first.
+ *
+ * Returns:		The CRC of the message.
+ *
+ *********************************************************************/
+crc_t
+crcFast(const uint8_t* message, size_t nBytes)
+{
+    crc_t    remainder = crcUpdate(crcStart, message, nBytes);
+
+    /*
+     * The final remainder is the CRC.
+     */
+    return (FAST_FINAL(remainder));
+
+}   /* crcFast() */
+
+
+/*********************************************************************
+ *
+ * Function:    crc_init()
+ * 
+ * Description: Start a running CRC calculation.
+ *
+ * Notes:		crcInit() must be called first.
+ *
+ * Returns:		None defined.
+ *
+ *********************************************************************/
+void
+crc_init(CRC_CTX* ctx)
+{
+    ctx->remainder = crcStart;
+
+}   /* crc_init() */
+
+
+/*********************************************************************
+ *
+ * Function:    crc_update()
+ * 
+ * Description: Divide the next piece of a message by the polynomial.
+ *
+ * Notes:		crcInit() must be called first.
+ *
+ * Returns:		None defined.
+ *
+ *********************************************************************/
+void
+crc_update(CRC_CTX* ctx, const uint8_t* message, size_t nBytes)
+{
+    ctx->remainder = crcUpdate(ctx->remainder, message, nBytes);
+
+}   /* crc_update() */
+
+
+/*********************************************************************
+ *
+ * Function:    crc_copy()
+ * 
+ * Description: Copy the next piece of a message and divide it by the
+ *				polynomial, reading the source only once.
+ *
+ * Notes:		crcInit() must be called first.  The buffers must not
+ *				overlap.  The table path is fused byte for byte; the
+ *				PCLMULQDQ and crc32 kernels run on CRC_COPY_BLOCK-byte
+ *				blocks of the destination right after each is copied,
+ *				while the block is still in the L1 cache.
+ *
+ * Returns:		None defined.
+ *
+ *********************************************************************/
+void
+crc_copy(uint8_t* dst, const uint8_t* src, size_t nBytes, CRC_CTX* ctx)
+{
+    crc_t    remainder = ctx->remainder;
+
+#if defined(USE_CRC_CLMUL) || defined(USE_CRC_SSE42)
+    size_t   block;
+
+    if (crcAccelerated())
+    {
+        for ( ; nBytes > 0; nBytes -= block)
+        {
+            block = (nBytes < CRC_COPY_BLOCK) ? nBytes : CRC_COPY_BLOCK;
+            memcpy(dst, src, block);
+            remainder = crcUpdate(remainder, dst, block);
+            src += block;
+            dst += block;
+        }
+        ctx->remainder = remainder;
+        return;
+    }
+#endif
+
+    ctx->remainder = crcTableCopy(remainder, dst, src, nBytes);
+
+}   /* crc_copy() */
+
+
+/*********************************************************************
+ *
+ * Function:    crc_iov()
+ * 
+ * Description: Compute the CRC of a message held in a list of
+ *				segments.
+ *
+ * Notes:		crcInit() must be called first.
+ *
+ * Returns:		The CRC of the segments, in order.
+ *
+ *********************************************************************/
+crc_t
+crc_iov(const struct iovec* iov, int iovcnt)
+{
+    crc_t    remainder = crcStart;
+    int      i;
+
+
+    for (i = 0; i < iovcnt; ++i)
+    {
+        remainder = crcUpdate(remainder, (const uint8_t*)iov[i].iov_base, iov[i].iov_len);
+    }
+
+    return (FAST_FINAL(remainder));
+
+}   /* crc_iov() */
+
+
+/*********************************************************************
+ *
+ * Function:    crc_final()
+ * 
+ * Description: Compute the CRC of the message so far.
+ *
+ * Returns:		The CRC of the message.
+ *
+ *********************************************************************/
+crc_t
+crc_final(const CRC_CTX* ctx)
+{
+    return (FAST_FINAL(ctx->remainder));
+
+}   /* crc_final() */
 
 #endif // USE_CRC_FAST
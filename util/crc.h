@@ -14,6 +14,37 @@
  *
  * Modification History:
  *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_patch(), crc_patch_op() and crc_shift_op().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_iov().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_copy().
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added USE_CRC_NIBBLE and CRC_TABLE_BYTES.  The standard and the
+ * accelerated paths can be chosen from the compiler command line.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC-64/ECMA-182 and CRC-64/XZ.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added the crc_init/crc_update/crc_final streaming interface.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added crc_combine().  Message lengths are now size_t.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC-32C (Castagnoli) and USE_CRC_SSE42.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added USE_CRC_CLMUL for the PCLMULQDQ folding kernels.
+ *
+ * 10/18/2026 - Tom Kerr
+ * Added CRC_SLICE_BY to select slicing-by-8/16 in crcFast.
+ *
  * 08/30/2015 - Tom Kerr
  * Downloaded from the Barr Group website:
  *   http://www.barrgroup.com/Embedded-Systems/How-To/CRC-Calculation-C-Code
@@ -25,13 +56,22 @@
 #define _crc_h
 
 #include <stdint.h>
+#include <stddef.h>
+#include "Iovec.h"
 
 /*
- * Select the CRC standard from the list that follows.
+ * Select the CRC standard from the list that follows, or define one of
+ * them on the compiler command line.
  */
+#if !defined(CRC_CCITT) && !defined(CRC16) && !defined(CRC32) && !defined(CRC32C) && \
+    !defined(CRC64_ECMA) && !defined(CRC64_XZ)
 #define CRC_CCITT
 //#define CRC16
 //#define CRC32
+//#define CRC32C
+//#define CRC64_ECMA
+//#define CRC64_XZ
+#endif
 
 
 #if defined(CRC_CCITT)
@@ -70,9 +110,45 @@ typedef uint32_t crc_t;
 #define REFLECT_REMAINDER	1
 #define CHECK_VALUE			0xCBF43926
 
+#elif defined(CRC32C)
+
+typedef uint32_t crc_t;
+
+#define CRC_NAME			"CRC-32C"
+#define POLYNOMIAL			0x1EDC6F41
+#define INITIAL_REMAINDER	0xFFFFFFFF
+#define FINAL_XOR_VALUE		0xFFFFFFFF
+#define REFLECT_DATA		1
+#define REFLECT_REMAINDER	1
+#define CHECK_VALUE			0xE3069283
+
+#elif defined(CRC64_ECMA)
+
+typedef uint64_t crc_t;
+
+#define CRC_NAME			"CRC-64/ECMA-182"
+#define POLYNOMIAL			0x42F0E1EBA9EA3693ULL
+#define INITIAL_REMAINDER	0x0000000000000000ULL
+#define FINAL_XOR_VALUE		0x0000000000000000ULL
+#define REFLECT_DATA		0
+#define REFLECT_REMAINDER	0
+#define CHECK_VALUE			0x6C40DF5F0B497347ULL
+
+#elif defined(CRC64_XZ)
+
+typedef uint64_t crc_t;
+
+#define CRC_NAME			"CRC-64/XZ"
+#define POLYNOMIAL			0x42F0E1EBA9EA3693ULL
+#define INITIAL_REMAINDER	0xFFFFFFFFFFFFFFFFULL
+#define FINAL_XOR_VALUE		0xFFFFFFFFFFFFFFFFULL
+#define REFLECT_DATA		1
+#define REFLECT_REMAINDER	1
+#define CHECK_VALUE			0x995DC9BBDF1939FAULL
+
 #else
 
-#error "One of CRC_CCITT, CRC16, or CRC32 must be #define'd."
+#error "One of CRC_CCITT, CRC16, CRC32, CRC32C, CRC64_ECMA, or CRC64_XZ must be #define'd."
 
 #endif
 
@@ -85,13 +161,141 @@ typedef uint32_t crc_t;
 #define USE_CRC_FAST
 
 
+/*
+ * CRC_SLICE_BY selects the number of message bytes crcFast consumes per
+ * iteration: 1 (classic byte-wise table), 8 or 16 (slicing-by-N).
+ * Slicing-by-N needs N lookup tables, i.e. N * 256 * sizeof(crc_t) bytes
+ * of RAM, so it defaults to 1 on AVR and 8 everywhere else.
+ */
+#if !defined(CRC_SLICE_BY)
+#if defined(__AVR__)
+#define CRC_SLICE_BY		1
+#else
+#define CRC_SLICE_BY		8
+#endif
+#endif
+
+#if (CRC_SLICE_BY != 1) && (CRC_SLICE_BY != 8) && (CRC_SLICE_BY != 16)
+#error "CRC_SLICE_BY must be 1, 8, or 16."
+#endif
+
+
+/*
+ * If USE_CRC_NIBBLE is defined, crcFast uses a 16-entry table and two
+ * lookups per byte instead of the 256-entry table: 16 * sizeof(crc_t)
+ * bytes of RAM at roughly half the speed of the byte-wise table.
+ * CRC_SLICE_BY must be 1.
+ */
+//#define USE_CRC_NIBBLE
+
+#if defined(USE_CRC_NIBBLE) && (CRC_SLICE_BY != 1)
+#error "USE_CRC_NIBBLE requires CRC_SLICE_BY 1."
+#endif
+
+
+/*
+ * RAM used by the crcFast lookup tables, in bytes.  The PCLMULQDQ and
+ * SSE4.2 paths below add a few constants (and 8 KiB of shift tables for
+ * CRC-32C).
+ */
+#if defined(USE_CRC_NIBBLE)
+#define CRC_TABLE_BYTES		(16 * sizeof(crc_t))
+#else
+#define CRC_TABLE_BYTES		(CRC_SLICE_BY * 256 * sizeof(crc_t))
+#endif
+
+
+/*
+ * If USE_CRC_CLMUL is defined, crcFast folds long messages 16 bytes at a
+ * time with the x86 carry-less multiply instruction (PCLMULQDQ), or 64
+ * bytes at a time with VPCLMULQDQ on AVX-512 parts.  crcInit() checks the
+ * CPU and falls back to the table path when neither is available.  Only
+ * meaningful for x86 GCC/Clang builds; defined automatically there unless
+ * NO_CRC_CLMUL is defined.
+ */
+#if defined(USE_CRC_FAST) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    !defined(NO_CRC_CLMUL)
+#define USE_CRC_CLMUL
+#endif
+
+
+/*
+ * If USE_CRC_SSE42 is defined, the CRC-32C standard uses the SSE4.2 crc32
+ * instruction, eight bytes at a time on three interleaved streams.
+ * crcInit() checks the CPU and falls back to the other paths without it.
+ * Defined automatically for CRC32C on x86 GCC/Clang builds unless
+ * NO_CRC_SSE42 is defined.
+ */
+#if defined(CRC32C) && defined(USE_CRC_FAST) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__)) && !defined(NO_CRC_SSE42)
+#define USE_CRC_SSE42
+#endif
+
+
+/*
+ * Running CRC calculation over a message that arrives in pieces.
+ */
+typedef struct
+{
+	crc_t remainder;		/* remainder of the data so far, before the final reflect/XOR */
+} CRC_CTX;
+
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 void  crcInit(void);
-crc_t crcSlow(const uint8_t* message, uint16_t nBytes);
-crc_t crcFast(const uint8_t* message, uint16_t nBytes);
+crc_t crcSlow(const uint8_t* message, size_t nBytes);
+crc_t crcFast(const uint8_t* message, size_t nBytes);
+
+/*
+ * Given crcA = CRC(A) and crcB = CRC(B), return CRC(A followed by B).
+ * lenB is the length of B in bytes.  Runs in O(log lenB) and needs no
+ * lookup tables, so crcInit() is not required.
+ */
+crc_t crc_combine(crc_t crcA, crc_t crcB, size_t lenB);
+
+/*
+ * Given crc = CRC of an nBytes message, return the CRC after the nChanged
+ * bytes at offset change from oldData to newData (offset + nChanged must
+ * not exceed nBytes).  Costs O(nChanged + log nBytes) instead of a pass
+ * over the message.  Like crc_combine(), needs no lookup tables.
+ *
+ * When many messages are patched at the same distance from their end,
+ * such as a header field of fixed-length records, compute
+ * shiftOp = crc_shift_op(nBytes - offset - nChanged) once and call
+ * crc_patch_op(), which then costs O(nChanged).
+ */
+crc_t crc_patch(crc_t crc, size_t nBytes, size_t offset,
+                const uint8_t* oldData, const uint8_t* newData, size_t nChanged);
+crc_t crc_shift_op(size_t nBytes);
+crc_t crc_patch_op(crc_t crc, crc_t shiftOp, const uint8_t* oldData, const uint8_t* newData, size_t nChanged);
+
+/*
+ * Streaming interface.  crc_init() starts a calculation, crc_update() adds
+ * the next piece of the message, and crc_final() returns the CRC of every
+ * piece so far, equal to crcFast() over the pieces concatenated.  crc_final()
+ * leaves the context alone, so more pieces may still follow.  Requires
+ * USE_CRC_FAST and crcInit().
+ */
+void  crc_init(CRC_CTX* ctx);
+void  crc_update(CRC_CTX* ctx, const uint8_t* message, size_t nBytes);
+crc_t crc_final(const CRC_CTX* ctx);
+
+/*
+ * Copy nBytes from src to dst and add them to a running CRC, reading the
+ * source once instead of once for the copy and again for crc_update().
+ * The buffers must not overlap.  Requires USE_CRC_FAST and crcInit().
+ */
+void  crc_copy(uint8_t* dst, const uint8_t* src, size_t nBytes, CRC_CTX* ctx);
+
+/*
+ * CRC of the concatenation of iovcnt segments, equal to crcFast() over the
+ * segments gathered into one buffer, without gathering them.  Requires
+ * USE_CRC_FAST and crcInit().
+ */
+crc_t crc_iov(const struct iovec* iov, int iovcnt);
 
 #ifdef __cplusplus
 }
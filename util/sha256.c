@@ -18,6 +18,23 @@
 *
 * Modification History:
 *
+* 10/18/2026  Tom Kerr
+* Added HMAC-SHA256, HKDF and PBKDF2.
+*
+* 10/18/2026  Tom Kerr
+* Added sha256_32() and sha256_64().
+*
+* 10/18/2026  Tom Kerr
+* Added sha256_many() with AVX2 and AVX-512 multi-buffer kernels.
+*
+* 10/18/2026  Tom Kerr
+* sha256_update() tops up a partial block, then hashes whole blocks
+* straight from the input with one sha256_transform() call.
+*
+* 10/18/2026  Tom Kerr
+* sha256_transform() is public and takes any number of blocks.  Added a
+* SHA-NI kernel selected with CPUID, keeping the C rounds as fallback.
+*
 * 08/30/2015  Tom Kerr
 * Obtained from http://bradconte.com/sha256_c and modified for 
 * general embedded systems use.
@@ -27,6 +44,13 @@
 #include <string.h>
 #include "sha256.h"
 
+#if defined(USE_SHA256_SHANI)
+#include <cpuid.h>
+#endif
+#if defined(USE_SHA256_SHANI) || defined(USE_SHA256_MB)
+#include <immintrin.h>
+#endif
+
 
 /****************************** MACROS ******************************/
 #define ROTLEFT(a,b) (((a) << (b)) | ((a) >> (32-(b))))
@@ -52,75 +76,597 @@ static const uint32_t k[64] = {
 	0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
 };
 
+static const uint32_t sha256_iv[8] = {
+	0x6a09e667,0xbb67ae85,0x3c6ef372,0xa54ff53a,0x510e527f,0x9b05688c,0x1f83d9ab,0x5be0cd19
+};
+
+// Message schedule of the block that pads a 64-byte message: 0x80, zeros
+// and a length of 512 bits.  Used by sha256_64().  Not on AVR, where it
+// would take 256 bytes of RAM; the padding block is hashed there instead.
+#if !defined(__AVR__)
+static const uint32_t sha256_pad64[64] = {
+	0x80000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,
+	0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000200,
+	0x80000000,0x01400000,0x00205000,0x00005088,0x22000800,0x22550014,0x05089742,0xa0000020,
+	0x5a880000,0x005c9400,0x0016d49d,0xfa801f00,0xd33225d0,0x11675959,0xf6e6bfda,0xb30c1549,
+	0x08b2b050,0x9d7c4c27,0x0ce2a393,0x88e6e1ea,0xa52b4335,0x67a16f49,0xd732016f,0x4eeb2e91,
+	0x5dbf55e5,0x8eee2335,0xe2bc5ec2,0xa83f4394,0x45ad78f7,0x36f3d0cd,0xd99c05e8,0xb0511dc7,
+	0x69bc7ac4,0xbd11375b,0xe3ba71e5,0x3b209ff2,0x18feee17,0xe25ad9e7,0x13375046,0x0515089d,
+	0x4f0d0f04,0x2627484e,0x310128d2,0xc668b434,0x420841cc,0x62d311b8,0xe59ba771,0x85a7a484
+};
+#endif
+
+#if defined(USE_SHA256_MB)
+#define SHA256_MAX_LANES 16
+
+// One message in a lane of the multi-buffer kernels.
+typedef struct {
+	const uint8_t *data;      // Next whole block of the message
+	size_t blocks;            // Whole blocks left
+	const uint8_t *tailnext;  // Next block of the tail
+	const uint8_t *tailend;   // End of the tail
+	int index;                // Message number, -1 for an idle lane
+	uint8_t tail[128];        // Partial last block, padding and length
+} SHA256_LANE;
+#endif
+
+#if defined(USE_SHA256_SHANI)
+// -1 until CPUID has been read, then 1 if the SHA extensions are present.
+// Read and written atomically, as the hash may run on several threads.
+static int sha256_shani = -1;
+#endif
+
 /*********************** FUNCTION DEFINITIONS ***********************/
-static void sha256_transform(SHA256_CTX *ctx, const uint8_t data[])
+// The 64 rounds of one block, given its message schedule.
+static void sha256_rounds_c(uint32_t state[8], const uint32_t m[64])
+{
+	uint32_t a, b, c, d, e, f, g, h, i, t1, t2;
+
+	a = state[0];
+	b = state[1];
+	c = state[2];
+	d = state[3];
+	e = state[4];
+	f = state[5];
+	g = state[6];
+	h = state[7];
+
+	for (i = 0; i < 64; ++i) {
+		t1 = h + EP1(e) + CH(e,f,g) + k[i] + m[i];
+		t2 = EP0(a) + MAJ(a,b,c);
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
+}
+
+static void sha256_transform_c(uint32_t state[8], const uint8_t data[])
 {
-	uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
+	uint32_t i, j, m[64];
 
 	for (i = 0, j = 0; i < 16; ++i, j += 4)
 		m[i] = ((uint32_t)data[j] << 24) | ((uint32_t)data[j + 1] << 16) | ((uint32_t)data[j + 2] << 8) | ((uint32_t)data[j + 3]);
 	for ( ; i < 64; ++i)
 		m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
+	sha256_rounds_c(state, m);
+}
+
+#if defined(USE_SHA256_SHANI)
+static int sha256_has_shani(void)
+{
+	unsigned int eax, ebx, ecx, edx;
+	int found = 0;
+
+	// SHA is CPUID.(EAX=7,ECX=0):EBX[29]; the kernel also uses SSSE3 and
+	// SSE4.1, CPUID.1:ECX[9] and [19].
+	if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 9)) && (ecx & (1u << 19)) &&
+	    __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1u << 29)))
+		found = 1;
+
+	__atomic_store_n(&sha256_shani, found, __ATOMIC_RELAXED);
+	return found;
+}
+
+static int sha256_shani_present(void)
+{
+	int found = __atomic_load_n(&sha256_shani, __ATOMIC_RELAXED);
+
+	return (found < 0) ? sha256_has_shani() : found;
+}
+
+#define SHA256_SHANI() sha256_shani_present()
+
+// One SHA-NI step of four rounds: message words plus constants, two rounds
+// into the CDGH half and two into the ABEF half.
+#define SHANI_ROUNDS(msg, g) \
+	tmp = _mm_add_epi32(msg, _mm_loadu_si128((const __m128i *)&k[4 * (g)])); \
+	state1 = _mm_sha256rnds2_epu32(state1, state0, tmp); \
+	state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(tmp, 0x0E))
+
+// Next four schedule words from the previous sixteen, m0 being the oldest.
+#define SHANI_SCHEDULE(m0, m1, m2, m3) \
+	m0 = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(m0, m1), _mm_alignr_epi8(m3, m2, 4)), m3)
+
+// The 64 rounds of a block whose first sixteen message words are in m0 to m3.
+#define SHANI_BLOCK() \
+	SHANI_ROUNDS(m0, 0); \
+	SHANI_ROUNDS(m1, 1); \
+	SHANI_ROUNDS(m2, 2); \
+	SHANI_ROUNDS(m3, 3); \
+	SHANI_SCHEDULE(m0, m1, m2, m3); SHANI_ROUNDS(m0, 4); \
+	SHANI_SCHEDULE(m1, m2, m3, m0); SHANI_ROUNDS(m1, 5); \
+	SHANI_SCHEDULE(m2, m3, m0, m1); SHANI_ROUNDS(m2, 6); \
+	SHANI_SCHEDULE(m3, m0, m1, m2); SHANI_ROUNDS(m3, 7); \
+	SHANI_SCHEDULE(m0, m1, m2, m3); SHANI_ROUNDS(m0, 8); \
+	SHANI_SCHEDULE(m1, m2, m3, m0); SHANI_ROUNDS(m1, 9); \
+	SHANI_SCHEDULE(m2, m3, m0, m1); SHANI_ROUNDS(m2, 10); \
+	SHANI_SCHEDULE(m3, m0, m1, m2); SHANI_ROUNDS(m3, 11); \
+	SHANI_SCHEDULE(m0, m1, m2, m3); SHANI_ROUNDS(m0, 12); \
+	SHANI_SCHEDULE(m1, m2, m3, m0); SHANI_ROUNDS(m1, 13); \
+	SHANI_SCHEDULE(m2, m3, m0, m1); SHANI_ROUNDS(m2, 14); \
+	SHANI_SCHEDULE(m3, m0, m1, m2); SHANI_ROUNDS(m3, 15)
+
+__attribute__((target("sha,ssse3,sse4.1")))
+static void sha256_transform_shani(uint32_t state[8], const uint8_t data[], size_t nblocks)
+{
+	const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+	__m128i state0, state1, abef, cdgh, tmp, m0, m1, m2, m3;
+
+	// The rounds instruction keeps the state as ABEF and CDGH.
+	tmp    = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xB1);
+	state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1B);
+	state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+	for ( ; nblocks > 0; --nblocks, data += 64) {
+		abef = state0;
+		cdgh = state1;
+
+		m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 0)), bswap);
+		m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16)), bswap);
+		m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 32)), bswap);
+		m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 48)), bswap);
+		SHANI_BLOCK();
 
-	a = ctx->state[0];
-	b = ctx->state[1];
-	c = ctx->state[2];
-	d = ctx->state[3];
-	e = ctx->state[4];
-	f = ctx->state[5];
-	g = ctx->state[6];
-	h = ctx->state[7];
+		state0 = _mm_add_epi32(state0, abef);
+		state1 = _mm_add_epi32(state1, cdgh);
+	}
+
+	// Back to ABCD and EFGH.
+	tmp    = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+	state1 = _mm_alignr_epi8(state1, tmp, 8);
+	_mm_storeu_si128((__m128i *)&state[0], state0);
+	_mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+// sha256_32_from() (len 32) and sha256_64() (len 64, from the IV, bits
+// 512).  The padding words are constants in registers, and the digest is
+// stored from them byte swapped.
+__attribute__((target("sha,ssse3,sse4.1")))
+static void sha256_fixed_shani(const uint32_t start[8], const uint8_t data[], int len, uint32_t bits, uint8_t hash[])
+{
+	const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+	__m128i state0, state1, abef, cdgh, tmp, m0, m1, m2, m3;
+
+	tmp    = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&start[0]), 0xB1);
+	state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&start[4]), 0x1B);
+	state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+	abef = state0;
+	cdgh = state1;
+
+	m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 0)), bswap);
+	m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16)), bswap);
+	if (len == 64) {
+		m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 32)), bswap);
+		m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 48)), bswap);
+	}
+	else {
+		m2 = _mm_set_epi32(0, 0, 0, (int)0x80000000);
+		m3 = _mm_set_epi32((int)bits, 0, 0, 0);
+	}
+	SHANI_BLOCK();
+	state0 = _mm_add_epi32(state0, abef);
+	state1 = _mm_add_epi32(state1, cdgh);
+
+	if (len == 64) {
+		abef = state0;
+		cdgh = state1;
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[0]), 0);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[4]), 1);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[8]), 2);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[12]), 3);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[16]), 4);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[20]), 5);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[24]), 6);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[28]), 7);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[32]), 8);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[36]), 9);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[40]), 10);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[44]), 11);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[48]), 12);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[52]), 13);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[56]), 14);
+		SHANI_ROUNDS(_mm_loadu_si128((const __m128i *)&sha256_pad64[60]), 15);
+		state0 = _mm_add_epi32(state0, abef);
+		state1 = _mm_add_epi32(state1, cdgh);
+	}
+
+	tmp    = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+	state1 = _mm_alignr_epi8(state1, tmp, 8);
+	_mm_storeu_si128((__m128i *)(hash + 0), _mm_shuffle_epi8(state0, bswap));
+	_mm_storeu_si128((__m128i *)(hash + 16), _mm_shuffle_epi8(state1, bswap));
+}
+#endif
+
+// Since this implementation uses little endian byte ordering and SHA uses big endian,
+// reverse all the bytes when copying the final state to the output hash.
+static void sha256_put_hash(const uint32_t state[8], uint8_t hash[])
+{
+	uint32_t i;
+
+	for (i = 0; i < 8; ++i, hash += 4) {
+		hash[0] = (state[i] >> 24) & 0x000000ff;
+		hash[1] = (state[i] >> 16) & 0x000000ff;
+		hash[2] = (state[i] >> 8) & 0x000000ff;
+		hash[3] = state[i] & 0x000000ff;
+	}
+}
+
+#if defined(USE_SHA256_MB)
+static int sha256_use_shani(void)
+{
+#if defined(USE_SHA256_SHANI)
+	return SHA256_SHANI();
+#else
+	return 0;
+#endif
+}
+
+// Nonzero if the messages average fewer than two blocks each, padding
+// included.  A single block is hashed faster with SHA-NI one message at a
+// time than in 16 AVX-512 lanes.
+static int sha256_single_blocks(const size_t lens[], int n)
+{
+	size_t blocks = 0;
+	int i;
+
+	for (i = 0; i < n; ++i)
+		blocks += (lens[i] + 8) / 64 + 1;
+	return blocks < 2 * (size_t)n;
+}
+
+#define MB_ROR(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+// Compression of one block in each of 8 lanes.  state holds word i of lane
+// j at [i * 8 + j], and w the big endian message words the same way.
+__attribute__((target("avx2")))
+static void sha256_x8_avx2(uint32_t *state, const uint32_t *w)
+{
+	__m256i a, b, c, d, e, f, g, h, t1, t2, x, y, m[16];
+	int i;
+
+	a = _mm256_loadu_si256((const __m256i *)(state + 0));
+	b = _mm256_loadu_si256((const __m256i *)(state + 8));
+	c = _mm256_loadu_si256((const __m256i *)(state + 16));
+	d = _mm256_loadu_si256((const __m256i *)(state + 24));
+	e = _mm256_loadu_si256((const __m256i *)(state + 32));
+	f = _mm256_loadu_si256((const __m256i *)(state + 40));
+	g = _mm256_loadu_si256((const __m256i *)(state + 48));
+	h = _mm256_loadu_si256((const __m256i *)(state + 56));
+	for (i = 0; i < 16; ++i)
+		m[i] = _mm256_loadu_si256((const __m256i *)(w + i * 8));
 
 	for (i = 0; i < 64; ++i) {
-		t1 = h + EP1(e) + CH(e,f,g) + k[i] + m[i];
-		t2 = EP0(a) + MAJ(a,b,c);
+		if (i >= 16) {
+			x = m[(i - 15) & 15];
+			y = m[(i - 2) & 15];
+			x = _mm256_xor_si256(_mm256_xor_si256(MB_ROR(x, 7), MB_ROR(x, 18)), _mm256_srli_epi32(x, 3));
+			y = _mm256_xor_si256(_mm256_xor_si256(MB_ROR(y, 17), MB_ROR(y, 19)), _mm256_srli_epi32(y, 10));
+			m[i & 15] = _mm256_add_epi32(_mm256_add_epi32(m[i & 15], x), _mm256_add_epi32(m[(i - 7) & 15], y));
+		}
+		t1 = _mm256_xor_si256(_mm256_xor_si256(MB_ROR(e, 6), MB_ROR(e, 11)), MB_ROR(e, 25));
+		t1 = _mm256_add_epi32(_mm256_add_epi32(h, t1), _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g)));
+		t1 = _mm256_add_epi32(t1, _mm256_add_epi32(_mm256_set1_epi32((int)k[i]), m[i & 15]));
+		t2 = _mm256_xor_si256(_mm256_xor_si256(MB_ROR(a, 2), MB_ROR(a, 13)), MB_ROR(a, 22));
+		t2 = _mm256_add_epi32(t2, _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b))));
 		h = g;
 		g = f;
 		f = e;
-		e = d + t1;
+		e = _mm256_add_epi32(d, t1);
 		d = c;
 		c = b;
 		b = a;
-		a = t1 + t2;
+		a = _mm256_add_epi32(t1, t2);
 	}
 
-	ctx->state[0] += a;
-	ctx->state[1] += b;
-	ctx->state[2] += c;
-	ctx->state[3] += d;
-	ctx->state[4] += e;
-	ctx->state[5] += f;
-	ctx->state[6] += g;
-	ctx->state[7] += h;
+	_mm256_storeu_si256((__m256i *)(state + 0), _mm256_add_epi32(a, _mm256_loadu_si256((const __m256i *)(state + 0))));
+	_mm256_storeu_si256((__m256i *)(state + 8), _mm256_add_epi32(b, _mm256_loadu_si256((const __m256i *)(state + 8))));
+	_mm256_storeu_si256((__m256i *)(state + 16), _mm256_add_epi32(c, _mm256_loadu_si256((const __m256i *)(state + 16))));
+	_mm256_storeu_si256((__m256i *)(state + 24), _mm256_add_epi32(d, _mm256_loadu_si256((const __m256i *)(state + 24))));
+	_mm256_storeu_si256((__m256i *)(state + 32), _mm256_add_epi32(e, _mm256_loadu_si256((const __m256i *)(state + 32))));
+	_mm256_storeu_si256((__m256i *)(state + 40), _mm256_add_epi32(f, _mm256_loadu_si256((const __m256i *)(state + 40))));
+	_mm256_storeu_si256((__m256i *)(state + 48), _mm256_add_epi32(g, _mm256_loadu_si256((const __m256i *)(state + 48))));
+	_mm256_storeu_si256((__m256i *)(state + 56), _mm256_add_epi32(h, _mm256_loadu_si256((const __m256i *)(state + 56))));
+}
+
+// As sha256_x8_avx2() for 16 lanes, with the rotates and the three-input
+// functions done in single instructions.
+__attribute__((target("avx512f")))
+static void sha256_x16_avx512(uint32_t *state, const uint32_t *w)
+{
+	__m512i v[8], a, b, c, d, e, f, g, h, t1, t2, x, y, m[16];
+	int i;
+
+	for (i = 0; i < 8; ++i)
+		v[i] = _mm512_loadu_si512((const void *)(state + i * 16));
+	for (i = 0; i < 16; ++i)
+		m[i] = _mm512_loadu_si512((const void *)(w + i * 16));
+	a = v[0]; b = v[1]; c = v[2]; d = v[3];
+	e = v[4]; f = v[5]; g = v[6]; h = v[7];
+
+	for (i = 0; i < 64; ++i) {
+		if (i >= 16) {
+			x = m[(i - 15) & 15];
+			y = m[(i - 2) & 15];
+			x = _mm512_ternarylogic_epi32(_mm512_ror_epi32(x, 7), _mm512_ror_epi32(x, 18), _mm512_srli_epi32(x, 3), 0x96);
+			y = _mm512_ternarylogic_epi32(_mm512_ror_epi32(y, 17), _mm512_ror_epi32(y, 19), _mm512_srli_epi32(y, 10), 0x96);
+			m[i & 15] = _mm512_add_epi32(_mm512_add_epi32(m[i & 15], x), _mm512_add_epi32(m[(i - 7) & 15], y));
+		}
+		// 0x96 is x ^ y ^ z, 0xCA is CH and 0xE8 is MAJ.
+		t1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25), 0x96);
+		t1 = _mm512_add_epi32(_mm512_add_epi32(h, t1), _mm512_ternarylogic_epi32(e, f, g, 0xCA));
+		t1 = _mm512_add_epi32(t1, _mm512_add_epi32(_mm512_set1_epi32((int)k[i]), m[i & 15]));
+		t2 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22), 0x96);
+		t2 = _mm512_add_epi32(t2, _mm512_ternarylogic_epi32(a, b, c, 0xE8));
+		h = g;
+		g = f;
+		f = e;
+		e = _mm512_add_epi32(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm512_add_epi32(t1, t2);
+	}
+
+	v[0] = _mm512_add_epi32(v[0], a); v[1] = _mm512_add_epi32(v[1], b);
+	v[2] = _mm512_add_epi32(v[2], c); v[3] = _mm512_add_epi32(v[3], d);
+	v[4] = _mm512_add_epi32(v[4], e); v[5] = _mm512_add_epi32(v[5], f);
+	v[6] = _mm512_add_epi32(v[6], g); v[7] = _mm512_add_epi32(v[7], h);
+	for (i = 0; i < 8; ++i)
+		_mm512_storeu_si512((void *)(state + i * 16), v[i]);
+}
+
+static void sha256_lane_start(SHA256_LANE *lane, const uint8_t msg[], size_t len, int index)
+{
+	size_t rem = len & 63;
+	uint64_t bitlen = (uint64_t)len * 8;
+	uint8_t *end;
+	int i;
+
+	lane->data = msg;
+	lane->blocks = len / 64;
+	lane->index = index;
+
+	// The last partial block with its padding and length: one block, or
+	// two if the length does not fit after the 0x80.
+	memset(lane->tail, 0, sizeof(lane->tail));
+	if (rem > 0)
+		memcpy(lane->tail, msg + len - rem, rem);
+	lane->tail[rem] = 0x80;
+	end = lane->tail + ((rem < 56) ? 64 : 128);
+	for (i = 1; i <= 8; ++i, bitlen >>= 8)
+		end[-i] = (uint8_t)bitlen;
+	lane->tailnext = lane->tail;
+	lane->tailend = end;
+}
+
+static const uint8_t *sha256_lane_next(SHA256_LANE *lane)
+{
+	const uint8_t *block;
+
+	if (lane->blocks > 0) {
+		block = lane->data;
+		lane->data += 64;
+		lane->blocks--;
+	}
+	else {
+		block = lane->tailnext;
+		lane->tailnext += 64;
+	}
+	return block;
+}
+
+static void sha256_many_lanes(const uint8_t *const msgs[], const size_t lens[], int n, uint8_t out[][SHA256_BLOCK_SIZE],
+                              int lanes, void (*kernel)(uint32_t *, const uint32_t *))
+{
+	static const uint8_t idle[64] = { 0 };
+	SHA256_LANE lane[SHA256_MAX_LANES];
+	uint32_t state[8 * SHA256_MAX_LANES];
+	uint32_t w[16 * SHA256_MAX_LANES];
+	uint32_t s[8];
+	const uint8_t *p;
+	int next = 0, active = 0, i, j;
+
+	for (i = 0; i < lanes; ++i) {
+		lane[i].index = -1;
+		if (next < n) {
+			sha256_lane_start(&lane[i], msgs[next], lens[next], next);
+			for (j = 0; j < 8; ++j)
+				state[j * lanes + i] = sha256_iv[j];
+			next++;
+			active++;
+		}
+	}
+
+	// Once the queue is empty and only a few lanes are busy, the vector
+	// kernel would mostly hash idle lanes; finish those messages below.
+	while (active > lanes / 4 || (active > 0 && next < n)) {
+		for (i = 0; i < lanes; ++i) {
+			p = (lane[i].index >= 0) ? sha256_lane_next(&lane[i]) : idle;
+			for (j = 0; j < 16; ++j, p += 4)
+				w[j * lanes + i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+		}
+		kernel(state, w);
+
+		for (i = 0; i < lanes; ++i) {
+			if (lane[i].index < 0 || lane[i].blocks > 0 || lane[i].tailnext < lane[i].tailend)
+				continue;
+			for (j = 0; j < 8; ++j)
+				s[j] = state[j * lanes + i];
+			sha256_put_hash(s, out[lane[i].index]);
+			if (next < n) {
+				sha256_lane_start(&lane[i], msgs[next], lens[next], next);
+				for (j = 0; j < 8; ++j)
+					state[j * lanes + i] = sha256_iv[j];
+				next++;
+			}
+			else {
+				lane[i].index = -1;
+				active--;
+			}
+		}
+	}
+
+	for (i = 0; i < lanes; ++i) {
+		if (lane[i].index < 0)
+			continue;
+		for (j = 0; j < 8; ++j)
+			s[j] = state[j * lanes + i];
+		sha256_transform(s, lane[i].data, lane[i].blocks);
+		sha256_transform(s, lane[i].tailnext, (size_t)(lane[i].tailend - lane[i].tailnext) / 64);
+		sha256_put_hash(s, out[lane[i].index]);
+	}
+}
+#endif
+
+void sha256_transform(uint32_t state[8], const uint8_t data[], size_t nblocks)
+{
+#if defined(USE_SHA256_SHANI)
+	if (SHA256_SHANI()) {
+		sha256_transform_shani(state, data, nblocks);
+		return;
+	}
+#endif
+	for ( ; nblocks > 0; --nblocks, data += 64)
+		sha256_transform_c(state, data);
+}
+
+// Finishes a hash whose last 32 bytes are data, from the state after the
+// blocks before them, bits being the length of the whole message in bits.
+static void sha256_32_from(const uint32_t start[8], const uint8_t data[32], uint32_t bits, uint8_t hash[])
+{
+	uint32_t state[8], i, j, m[64];
+
+#if defined(USE_SHA256_SHANI)
+	if (SHA256_SHANI()) {
+		sha256_fixed_shani(start, data, 32, bits, hash);
+		return;
+	}
+#endif
+	// One block: the data, 0x80, zeros and the length.
+	memcpy(state, start, sizeof(state));
+	for (i = 0, j = 0; i < 8; ++i, j += 4)
+		m[i] = ((uint32_t)data[j] << 24) | ((uint32_t)data[j + 1] << 16) | ((uint32_t)data[j + 2] << 8) | ((uint32_t)data[j + 3]);
+	m[8] = 0x80000000;
+	m[9] = m[10] = m[11] = m[12] = m[13] = m[14] = 0;
+	m[15] = bits;
+	for (i = 16; i < 64; ++i)
+		m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
+	sha256_rounds_c(state, m);
+	sha256_put_hash(state, hash);
+}
+
+void sha256_32(const uint8_t data[32], uint8_t hash[])
+{
+	sha256_32_from(sha256_iv, data, 256, hash);
+}
+
+void sha256_64(const uint8_t data[64], uint8_t hash[])
+{
+	uint32_t state[8];
+#if defined(__AVR__)
+	uint8_t pad[64];
+#endif
+
+#if defined(USE_SHA256_SHANI)
+	if (SHA256_SHANI()) {
+		sha256_fixed_shani(sha256_iv, data, 64, 512, hash);
+		return;
+	}
+#endif
+	memcpy(state, sha256_iv, sizeof(state));
+	sha256_transform_c(state, data);
+#if defined(__AVR__)
+	memset(pad, 0, sizeof(pad));
+	pad[0] = 0x80;
+	pad[62] = 0x02;
+	sha256_transform_c(state, pad);
+#else
+	sha256_rounds_c(state, sha256_pad64);
+#endif
+	sha256_put_hash(state, hash);
 }
 
 void sha256_init(SHA256_CTX *ctx)
 {
 	ctx->datalen = 0;
 	ctx->bitlen = 0;
-	ctx->state[0] = 0x6a09e667;
-	ctx->state[1] = 0xbb67ae85;
-	ctx->state[2] = 0x3c6ef372;
-	ctx->state[3] = 0xa54ff53a;
-	ctx->state[4] = 0x510e527f;
-	ctx->state[5] = 0x9b05688c;
-	ctx->state[6] = 0x1f83d9ab;
-	ctx->state[7] = 0x5be0cd19;
+	memcpy(ctx->state, sha256_iv, sizeof(sha256_iv));
 }
 
 void sha256_update(SHA256_CTX *ctx, const uint8_t data[], size_t len)
 {
-	uint32_t i;
+	size_t n;
 
-	for (i = 0; i < len; ++i) {
-		ctx->data[ctx->datalen] = data[i];
-		ctx->datalen++;
-		if (ctx->datalen == 64) {
-			sha256_transform(ctx, ctx->data);
-			ctx->bitlen += 512;
-			ctx->datalen = 0;
-		}
+	// Nothing to add; data may be NULL.
+	if (len == 0)
+		return;
+
+	// Top up a partial block from an earlier call.
+	if (ctx->datalen > 0) {
+		n = 64 - ctx->datalen;
+		if (n > len)
+			n = len;
+		memcpy(ctx->data + ctx->datalen, data, n);
+		ctx->datalen += (uint32_t)n;
+		data += n;
+		len -= n;
+		if (ctx->datalen < 64)
+			return;
+		sha256_transform(ctx->state, ctx->data, 1);
+		ctx->bitlen += 512;
+		ctx->datalen = 0;
+	}
+
+	// Hash the whole blocks in place, and buffer only the tail.
+	n = len / 64;
+	if (n > 0) {
+		sha256_transform(ctx->state, data, n);
+		ctx->bitlen += (uint64_t)n * 512;
+		data += n * 64;
+		len -= n * 64;
 	}
+	memcpy(ctx->data, data, len);
+	ctx->datalen = (uint32_t)len;
 }
 
 void sha256_final(SHA256_CTX *ctx, uint8_t hash[])
@@ -139,7 +685,7 @@ void sha256_final(SHA256_CTX *ctx, uint8_t hash[])
 		ctx->data[i++] = 0x80;
 		while (i < 64)
 			ctx->data[i++] = 0x00;
-		sha256_transform(ctx, ctx->data);
+		sha256_transform(ctx->state, ctx->data, 1);
 		memset(ctx->data, 0, 56);
 	}
 
@@ -153,19 +699,172 @@ void sha256_final(SHA256_CTX *ctx, uint8_t hash[])
 	ctx->data[58] = ctx->bitlen >> 40;
 	ctx->data[57] = ctx->bitlen >> 48;
 	ctx->data[56] = ctx->bitlen >> 56;
-	sha256_transform(ctx, ctx->data);
+	sha256_transform(ctx->state, ctx->data, 1);
 
-	// Since this implementation uses little endian byte ordering and SHA uses big endian,
-	// reverse all the bytes when copying the final state to the output hash.
-	for (i = 0; i < 4; ++i) {
-		hash[i]      = (ctx->state[0] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 4]  = (ctx->state[1] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 8]  = (ctx->state[2] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 12] = (ctx->state[3] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 16] = (ctx->state[4] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 20] = (ctx->state[5] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 24] = (ctx->state[6] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 28] = (ctx->state[7] >> (24 - i * 8)) & 0x000000ff;
+	sha256_put_hash(ctx->state, hash);
+}
+
+void sha256_many(const uint8_t *const msgs[], const size_t lens[], int n, uint8_t out[][SHA256_BLOCK_SIZE])
+{
+	SHA256_CTX ctx;
+	int i;
+
+#if defined(USE_SHA256_MB)
+	if (n > 1) {
+		if (__builtin_cpu_supports("avx512f") &&
+		    !(sha256_use_shani() && sha256_single_blocks(lens, n))) {
+			sha256_many_lanes(msgs, lens, n, out, 16, sha256_x16_avx512);
+			return;
+		}
+		// One message at a time with SHA-NI is faster than 8 AVX2 lanes.
+		if (__builtin_cpu_supports("avx2") && !sha256_use_shani()) {
+			sha256_many_lanes(msgs, lens, n, out, 8, sha256_x8_avx2);
+			return;
+		}
+	}
+#endif
+	for (i = 0; i < n; ++i) {
+		sha256_init(&ctx);
+		sha256_update(&ctx, msgs[i], lens[i]);
+		sha256_final(&ctx, out[i]);
 	}
 }
 
+void hmac_sha256_key(HMAC_SHA256_KEY *hkey, const uint8_t key[], size_t keylen)
+{
+	SHA256_CTX ctx;
+	uint8_t block[64];
+	size_t i;
+
+	// Keys longer than a block are hashed first, and all are padded to a
+	// block with zeros.
+	memset(block, 0, sizeof(block));
+	if (keylen > sizeof(block)) {
+		sha256_init(&ctx);
+		sha256_update(&ctx, key, keylen);
+		sha256_final(&ctx, block);
+	}
+	else if (keylen > 0)
+		memcpy(block, key, keylen);
+
+	for (i = 0; i < sizeof(block); ++i)
+		block[i] ^= 0x36;
+	memcpy(hkey->inner, sha256_iv, sizeof(sha256_iv));
+	sha256_transform(hkey->inner, block, 1);
+
+	for (i = 0; i < sizeof(block); ++i)
+		block[i] ^= 0x36 ^ 0x5c;
+	memcpy(hkey->outer, sha256_iv, sizeof(sha256_iv));
+	sha256_transform(hkey->outer, block, 1);
+}
+
+void hmac_sha256_init(HMAC_SHA256_CTX *ctx, const HMAC_SHA256_KEY *hkey)
+{
+	memcpy(ctx->sha.state, hkey->inner, sizeof(hkey->inner));
+	ctx->sha.datalen = 0;
+	ctx->sha.bitlen = 512;
+	memcpy(ctx->outer, hkey->outer, sizeof(hkey->outer));
+}
+
+void hmac_sha256_update(HMAC_SHA256_CTX *ctx, const uint8_t data[], size_t len)
+{
+	sha256_update(&ctx->sha, data, len);
+}
+
+void hmac_sha256_final(HMAC_SHA256_CTX *ctx, uint8_t mac[])
+{
+	uint8_t inner[SHA256_BLOCK_SIZE];
+
+	sha256_final(&ctx->sha, inner);
+	// The outer hash is the opad block, already absorbed, and the inner
+	// digest: 768 bits.
+	sha256_32_from(ctx->outer, inner, 768, mac);
+}
+
+void hmac_sha256(const uint8_t key[], size_t keylen, const uint8_t data[], size_t len, uint8_t mac[])
+{
+	HMAC_SHA256_KEY hkey;
+	HMAC_SHA256_CTX ctx;
+
+	hmac_sha256_key(&hkey, key, keylen);
+	hmac_sha256_init(&ctx, &hkey);
+	hmac_sha256_update(&ctx, data, len);
+	hmac_sha256_final(&ctx, mac);
+}
+
+void hkdf_sha256_extract(const uint8_t salt[], size_t saltlen, const uint8_t ikm[], size_t ikmlen, uint8_t prk[])
+{
+	// No salt is the same HMAC key as HashLen zero bytes.
+	hmac_sha256(salt, saltlen, ikm, ikmlen, prk);
+}
+
+int hkdf_sha256_expand(const uint8_t prk[], size_t prklen, const uint8_t info[], size_t infolen,
+                       uint8_t okm[], size_t okmlen)
+{
+	HMAC_SHA256_KEY hkey;
+	HMAC_SHA256_CTX ctx;
+	uint8_t t[SHA256_BLOCK_SIZE];
+	uint8_t counter;
+	size_t n;
+
+	if (okmlen > 255 * SHA256_BLOCK_SIZE)
+		return -1;
+
+	hmac_sha256_key(&hkey, prk, prklen);
+	for (counter = 1; okmlen > 0; ++counter, okm += n, okmlen -= n) {
+		hmac_sha256_init(&ctx, &hkey);
+		if (counter > 1)
+			hmac_sha256_update(&ctx, t, sizeof(t));
+		hmac_sha256_update(&ctx, info, infolen);
+		hmac_sha256_update(&ctx, &counter, 1);
+		hmac_sha256_final(&ctx, t);
+
+		n = (okmlen < sizeof(t)) ? okmlen : sizeof(t);
+		memcpy(okm, t, n);
+	}
+	return 0;
+}
+
+int hkdf_sha256(const uint8_t salt[], size_t saltlen, const uint8_t ikm[], size_t ikmlen,
+                const uint8_t info[], size_t infolen, uint8_t okm[], size_t okmlen)
+{
+	uint8_t prk[SHA256_BLOCK_SIZE];
+
+	hkdf_sha256_extract(salt, saltlen, ikm, ikmlen, prk);
+	return hkdf_sha256_expand(prk, sizeof(prk), info, infolen, okm, okmlen);
+}
+
+void pbkdf2_sha256(const uint8_t pass[], size_t passlen, const uint8_t salt[], size_t saltlen,
+                   uint32_t iterations, uint8_t out[], size_t outlen)
+{
+	HMAC_SHA256_KEY hkey;
+	HMAC_SHA256_CTX ctx;
+	uint8_t u[SHA256_BLOCK_SIZE], t[SHA256_BLOCK_SIZE], be[4];
+	uint32_t block, j;
+	size_t i, n;
+
+	hmac_sha256_key(&hkey, pass, passlen);
+	for (block = 1; outlen > 0; ++block, out += n, outlen -= n) {
+		be[0] = (uint8_t)(block >> 24);
+		be[1] = (uint8_t)(block >> 16);
+		be[2] = (uint8_t)(block >> 8);
+		be[3] = (uint8_t)block;
+		hmac_sha256_init(&ctx, &hkey);
+		hmac_sha256_update(&ctx, salt, saltlen);
+		hmac_sha256_update(&ctx, be, sizeof(be));
+		hmac_sha256_final(&ctx, u);
+		memcpy(t, u, sizeof(t));
+
+		// Each further HMAC is of a 32 byte message, so both its hashes
+		// are a 32 byte tail finished from a cached midstate.
+		for (j = 1; j < iterations; ++j) {
+			sha256_32_from(hkey.inner, u, 768, u);
+			sha256_32_from(hkey.outer, u, 768, u);
+			for (i = 0; i < sizeof(t); ++i)
+				t[i] ^= u[i];
+		}
+
+		n = (outlen < sizeof(t)) ? outlen : sizeof(t);
+		memcpy(out, t, n);
+	}
+}
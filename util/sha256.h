@@ -12,6 +12,23 @@
 *
 * Modification History:
 *
+* 10/18/2026  Tom Kerr
+* Added HMAC-SHA256, HKDF and PBKDF2-HMAC-SHA256.
+*
+* 10/18/2026  Tom Kerr
+* Added sha256_32() and sha256_64().
+*
+* 10/18/2026  Tom Kerr
+* Added sha256_many(), with AVX2 and AVX-512 multi-buffer kernels (see
+* USE_SHA256_MB).
+*
+* 10/18/2026  Tom Kerr
+* sha256_update() hashes whole blocks directly from the input.
+*
+* 10/18/2026  Tom Kerr
+* Added sha256_transform() over whole blocks, with a SHA-NI kernel
+* selected at run time (see USE_SHA256_SHANI).
+*
 * 08/30/2015  Tom Kerr
 * Obtained from http://bradconte.com/sha256_c and modified for 
 * general embedded systems use.
@@ -21,11 +38,27 @@
 #define _SHA256_H
 
 /*************************** HEADER FILES ***************************/
+#include <stddef.h>
 #include <stdint.h>
 
 /****************************** MACROS ******************************/
 #define SHA256_BLOCK_SIZE 32            // SHA256 outputs a 32 byte digest
 
+// Defined when sha256_transform() has a kernel for the x86 SHA extensions
+// (sha256rnds2, sha256msg1, sha256msg2), used on CPUs that report them in
+// CPUID.  Defined automatically for x86 GCC/Clang builds unless
+// NO_SHA256_SHANI is defined.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(NO_SHA256_SHANI)
+#define USE_SHA256_SHANI
+#endif
+
+// Defined when sha256_many() has AVX2 (8 lane) and AVX-512 (16 lane)
+// multi-buffer kernels, used on CPUs that have them.  Defined automatically
+// for x86 GCC/Clang builds unless NO_SHA256_MB is defined.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(NO_SHA256_MB)
+#define USE_SHA256_MB
+#endif
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,12 +73,72 @@ typedef struct {
    uint32_t state[8];
 } SHA256_CTX;
 
+// An HMAC key, kept as the hash states after the key XOR ipad and the key
+// XOR opad blocks, so each MAC hashes only the message and two final
+// blocks.  Set up once with hmac_sha256_key() and reuse.
+typedef struct {
+   uint32_t inner[8];
+   uint32_t outer[8];
+} HMAC_SHA256_KEY;
+
+typedef struct {
+   SHA256_CTX sha;
+   uint32_t outer[8];
+} HMAC_SHA256_CTX;
+
 void sha256_init(SHA256_CTX *ctx);
 
 void sha256_update(SHA256_CTX *ctx, const uint8_t data[], size_t len);
 
 void sha256_final(SHA256_CTX *ctx, uint8_t hash[]);
 
+// Runs the compression function over nblocks consecutive 64 byte blocks,
+// updating state.  No padding is added.  For building on the raw hash, such
+// as resuming from a saved midstate.
+void sha256_transform(uint32_t state[8], const uint8_t data[], size_t nblocks);
+
+// Hash exactly 32 or 64 bytes, such as a digest or a pair of digests in a
+// Merkle tree.  The padding is constant, and for sha256_64() so is the
+// message schedule of the padding block, so these skip the buffering and
+// padding of sha256_update() and sha256_final().
+void sha256_32(const uint8_t data[32], uint8_t hash[]);
+void sha256_64(const uint8_t data[64], uint8_t hash[]);
+
+// Hashes n independent messages, msgs[i] of lens[i] bytes, into out[i].
+// With USE_SHA256_MB the messages are hashed 8 or 16 at a time, one per
+// SIMD lane; a lane that finishes its message takes the next one, so the
+// lengths need not match.  Best for many short messages, such as keys and
+// digests of 64 to 512 bytes.  Where SHA-NI is present, messages that
+// average under two blocks (55 bytes or less) are hashed one at a time with
+// SHA-NI instead, as that is faster for a single block.
+void sha256_many(const uint8_t *const msgs[], const size_t lens[], int n, uint8_t out[][SHA256_BLOCK_SIZE]);
+
+// HMAC-SHA256 (RFC 2104).  hmac_sha256() is the one-shot form; the others
+// MAC many messages with one key, or one message in pieces.
+void hmac_sha256_key(HMAC_SHA256_KEY *hkey, const uint8_t key[], size_t keylen);
+
+void hmac_sha256_init(HMAC_SHA256_CTX *ctx, const HMAC_SHA256_KEY *hkey);
+
+void hmac_sha256_update(HMAC_SHA256_CTX *ctx, const uint8_t data[], size_t len);
+
+void hmac_sha256_final(HMAC_SHA256_CTX *ctx, uint8_t mac[]);
+
+void hmac_sha256(const uint8_t key[], size_t keylen, const uint8_t data[], size_t len, uint8_t mac[]);
+
+// HKDF-SHA256 (RFC 5869).  The expand step returns -1 if okmlen is over
+// 255 * SHA256_BLOCK_SIZE, else 0.  salt may be NULL with saltlen 0.
+void hkdf_sha256_extract(const uint8_t salt[], size_t saltlen, const uint8_t ikm[], size_t ikmlen, uint8_t prk[]);
+
+int hkdf_sha256_expand(const uint8_t prk[], size_t prklen, const uint8_t info[], size_t infolen,
+                       uint8_t okm[], size_t okmlen);
+
+int hkdf_sha256(const uint8_t salt[], size_t saltlen, const uint8_t ikm[], size_t ikmlen,
+                const uint8_t info[], size_t infolen, uint8_t okm[], size_t okmlen);
+
+// PBKDF2-HMAC-SHA256 (RFC 8018), deriving outlen bytes into out.
+void pbkdf2_sha256(const uint8_t pass[], size_t passlen, const uint8_t salt[], size_t saltlen,
+                   uint32_t iterations, uint8_t out[], size_t outlen);
+
 #ifdef __cplusplus
 }
 #endif